@@ -9,6 +9,7 @@
 #include "gtest/gtest.h"
 
 #include "utils/utils.hpp"
+#include "utils/utils_covering_array.hpp"
 #include "test_harness/test_harness.hpp"
 #include "logging/logging.hpp"
 
@@ -1037,12 +1038,12 @@ LZT_TEST_P(
 
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedTests, zeCommandListAppendMemoryBackToBackTests,
-    ::testing::Combine(::testing::Bool(), ::testing::Bool(), ::testing::Bool(),
-                       ::testing::Bool(),
-                       ::testing::Values(MemoryHint::None,
-                                         MemoryHint::AdviceToSystem,
-                                         MemoryHint::Prefetch),
-                       ::testing::Values(10, 10 * 1024, 32 * 1024 * 1024)));
+    lzt::CoveringCombine(::testing::Bool(), ::testing::Bool(),
+                         ::testing::Bool(), ::testing::Bool(),
+                         ::testing::Values(MemoryHint::None,
+                                           MemoryHint::AdviceToSystem,
+                                           MemoryHint::Prefetch),
+                         ::testing::Values(10, 10 * 1024, 32 * 1024 * 1024)));
 
 class zeCommandListAppendMemoryCopyFromContextWithDataVerificationTests
     : public zeCommandListCommandQueueTests {
@@ -1329,12 +1330,12 @@ auto memory_types = ::testing::Values(
 INSTANTIATE_TEST_SUITE_P(
     MemoryCopies,
     zeCommandListAppendMemoryCopyRegionWithDataVerificationParameterizedTests,
-    ::testing::Combine(::testing::Values(8, 64),    // Rows
-                       ::testing::Values(8, 64),    // Cols
-                       ::testing::Values(1, 8, 64), // Slices
-                       memory_types,                // Source Memory Type
-                       memory_types,                // Destination Memory Type
-                       ::testing::Bool()));
+    lzt::CoveringCombine(::testing::Values(8, 64),    // Rows
+                         ::testing::Values(8, 64),    // Cols
+                         ::testing::Values(1, 8, 64), // Slices
+                         memory_types,                // Source Memory Type
+                         memory_types, // Destination Memory Type
+                         ::testing::Bool()));
 class AppendMemoryCopyRegionWithSharedSystem
     : public ::testing::Test,
       public ::testing::WithParamInterface<
@@ -1866,12 +1867,12 @@ LZT_TEST_P(
 }
 
 INSTANTIATE_TEST_SUITE_P(MemoryCopies, AppendMemoryCopyRegionWithSharedSystem,
-                         ::testing::Combine(::testing::Values(8, 64), // Rows
-                                            ::testing::Values(8, 64), // Cols
-                                            ::testing::Values(1, 8,
-                                                              64), // Slices
-                                            ::testing::Bool(),
-                                            ::testing::Bool()));
+                         lzt::CoveringCombine(::testing::Values(8, 64), // Rows
+                                              ::testing::Values(8, 64), // Cols
+                                              ::testing::Values(1, 8,
+                                                                64), // Slices
+                                              ::testing::Bool(),
+                                              ::testing::Bool()));
 
 class zeCommandListAppendMemoryCopyTests : public ::testing::Test {
 protected:
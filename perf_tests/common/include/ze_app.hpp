@@ -27,12 +27,15 @@ public:
   void memoryAlloc(size_t size, void **ptr);
   void memoryAlloc(const uint32_t device_index, size_t size, void **ptr);
   void memoryAllocHost(size_t size, void **ptr);
+  void memoryAllocShared(const uint32_t device_index, size_t size, void **ptr);
   void memoryFree(const void *ptr);
   void memoryOpenIpcHandle(const uint32_t device_index,
                            ze_ipc_mem_handle_t pIpcHandle, void **zeIpcBuffer);
   void deviceGetCommandQueueGroupProperties(
       const uint32_t device_index, uint32_t *numQueueGroups,
       ze_command_queue_group_properties_t *queueProperties);
+  bool queueGroupOrdinal(const uint32_t device_index, bool copy_only,
+                         uint32_t *ordinal);
 
   void functionCreate(ze_kernel_handle_t *function, const char *pFunctionName);
   void functionCreate(const uint32_t device_index, ze_kernel_handle_t *function,
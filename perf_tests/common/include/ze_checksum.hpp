@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _ZE_CHECKSUM_HPP_
+#define _ZE_CHECKSUM_HPP_
+
+#include "ze_app.hpp"
+
+#include <cstdint>
+#include <map>
+
+// Must match CHUNK_SIZE and GROUP_SIZE in ze_checksum.cl
+constexpr size_t checksum_chunk_size = 4096;
+constexpr uint32_t checksum_group_size = 256;
+
+// 64-bit checksum of a buffer, computed where the buffer lives. The buffer
+// is split in chunks of checksum_chunk_size bytes, each chunk is hashed with
+// its index as seed and the hashes are added up, so the chunks are hashed
+// in parallel and summed in a tree. Device and shared allocations are
+// hashed on their device by the checksum kernel of ze_checksum.spv, which
+// reads back one partial sum per work-group, other memory is hashed on the
+// host. A transfer is validated by comparing the checksum of its
+// destination with host() of the expected data. Throws if ze_checksum.spv
+// cannot be loaded.
+class ZeChecksum {
+public:
+  ZeChecksum(ZeApp *app);
+  ~ZeChecksum();
+
+  static uint64_t host(const void *ptr, size_t size);
+  uint64_t compute(const void *ptr, size_t size);
+
+private:
+  struct device_state_t {
+    ze_module_handle_t module = nullptr;
+    ze_kernel_handle_t kernel = nullptr;
+    ze_command_list_handle_t command_list = nullptr;
+  };
+
+  device_state_t &device_state(ze_device_handle_t device);
+  uint64_t device_checksum(device_state_t &state, const void *ptr,
+                           size_t size);
+
+  ZeApp *app;
+  std::vector<uint8_t> module_binary;
+  std::map<ze_device_handle_t, device_state_t> devices;
+  uint64_t *group_sums = nullptr;
+  size_t group_sums_count = 0;
+};
+
+#endif /* _ZE_CHECKSUM_HPP_ */
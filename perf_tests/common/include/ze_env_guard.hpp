@@ -0,0 +1,84 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _ZE_ENV_GUARD_HPP_
+#define _ZE_ENV_GUARD_HPP_
+
+#include <level_zero/ze_api.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Defined in ze_env_guard_options.cpp, which only the benchmarks parsing
+// their options with boost build.
+namespace boost {
+namespace program_options {
+class options_description;
+}
+} // namespace boost
+
+enum governor_policy_t {
+  GOVERNOR_IGNORE = 0, /* record the governor only */
+  GOVERNOR_WARN = 1,   /* warn if it is not performance */
+  GOVERNOR_REFUSE = 2  /* refuse to run if it is not performance */
+};
+
+// Host environment of a benchmark run. Optionally pins the submitting
+// thread to a CPU local to the device, checks the CPU frequency governor
+// and turbo state, and measures the host noise before the run: the time
+// a spinning thread loses to interruptions, the load of the SMT sibling
+// of its CPU and of the other CPUs. Everything found is kept as metadata
+// to print or add to the JSON output. Only Linux is inspected, elsewhere
+// the values are reported as unknown.
+class ZeEnvGuard {
+public:
+  // Benchmarks which predate the guard pass GOVERNOR_IGNORE and 0, so that
+  // their default runs are neither delayed nor warned about.
+  explicit ZeEnvGuard(governor_policy_t governor_policy = GOVERNOR_WARN,
+                      uint32_t noise_msec = 100)
+      : governor_policy(governor_policy), noise_msec(noise_msec) {}
+
+  bool pin_cpu = false;
+  governor_policy_t governor_policy;
+  uint32_t noise_msec;
+
+  // --pin-cpu, --governor and --noise-msec, to add to the options of the
+  // benchmark. The defaults shown are the ones given to the constructor.
+  boost::program_options::options_description options(void);
+  // Applies the options for the thread calling it, which should be the
+  // one submitting the work. Returns false if the run should not go on.
+  bool apply(ze_device_handle_t device);
+  // apply() and print()
+  bool setup(ze_device_handle_t device);
+  void print(void) const;
+  // Adds the metadata to a JSON output tree, under
+  // "Performance Benchmark.environment"
+  template <typename Tree> void add_to(Tree &tree) const {
+    for (const auto &entry : metadata) {
+      tree.put("Performance Benchmark.environment." + entry.first,
+               entry.second);
+    }
+  }
+  // Parses "ignore", "warn" or "refuse", returns false for other values
+  bool parse_governor_policy(const std::string &policy);
+  static const char *governor_policy_name(governor_policy_t policy);
+
+  std::vector<std::pair<std::string, std::string>> metadata;
+
+private:
+  void record(const std::string &key, const std::string &value);
+  void pin_to_device_node(ze_device_handle_t device);
+  bool check_governor(void);
+  void check_turbo(void);
+  void measure_noise(void);
+
+  std::vector<int> cpus; /* CPUs the thread may run on */
+};
+
+#endif /* _ZE_ENV_GUARD_HPP_ */
@@ -0,0 +1,49 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _ZE_SAMPLE_STATS_HPP_
+#define _ZE_SAMPLE_STATS_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// Mean and standard deviation of the timed iterations of one measurement,
+// updated with Welford's method so the iterations are not kept. Written to
+// the JSON output next to the mean they belong to, they let
+// scripts/perf_variance.py compare the spread between runs with the spread
+// within a run.
+class ZeSampleStats {
+public:
+  void add(long double value) {
+    count++;
+    long double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+  }
+
+  long double stddev(void) const {
+    return count > 1 ? std::sqrt(m2 / (count - 1)) : 0;
+  }
+
+  // Adds "<field> stddev" and "<field> samples" next to field, which holds
+  // the mean
+  template <typename Tree>
+  void add_to(Tree &tree, const std::string &field) const {
+    tree.put(field + " stddev", stddev());
+    tree.put(field + " samples", count);
+  }
+
+  uint64_t count = 0;
+  long double mean = 0;
+
+private:
+  long double m2 = 0;
+};
+
+#endif /* _ZE_SAMPLE_STATS_HPP_ */
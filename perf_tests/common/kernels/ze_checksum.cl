@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+// Must match checksum_chunk_size and checksum_group_size in ze_checksum.hpp
+#define CHUNK_SIZE 4096
+#define GROUP_SIZE 256
+
+#define PRIME1 0x9E3779B185EBCA87UL
+#define PRIME2 0xC2B2AE3D27D4EB4FUL
+#define PRIME3 0x165667B19E3779F9UL
+#define PRIME5 0x27D4EB2F165667C5UL
+
+// Same hash as chunk_hash in ze_checksum.cpp, the last word is zero padded
+ulong chunk_hash(const global uchar *data, ulong size, ulong index) {
+  ulong acc = PRIME5 + index * PRIME1 + size;
+  for (ulong i = 0; i < size; i += 8) {
+    ulong word = 0;
+    if (i + 8 <= size) {
+      word = as_ulong(vload8(0, data + i));
+    } else {
+      for (ulong b = 0; i + b < size; b++) {
+        word |= (ulong)data[i + b] << (8 * b);
+      }
+    }
+    acc ^= rotate(word * PRIME2, 31UL) * PRIME1;
+    acc = rotate(acc, 27UL) * PRIME1 + PRIME3;
+  }
+  acc ^= acc >> 33;
+  acc *= PRIME2;
+  acc ^= acc >> 29;
+  acc *= PRIME3;
+  acc ^= acc >> 32;
+  return acc;
+}
+
+kernel __attribute__((reqd_work_group_size(GROUP_SIZE, 1, 1))) void
+checksum(const global uchar *src, ulong size, global ulong *group_sums) {
+  local ulong sums[GROUP_SIZE];
+  const size_t lid = get_local_id(0);
+  const ulong chunk = get_global_id(0);
+  const ulong begin = chunk * CHUNK_SIZE;
+
+  ulong hash = 0;
+  if (begin < size) {
+    hash = chunk_hash(src + begin, min((ulong)CHUNK_SIZE, size - begin), chunk);
+  }
+  sums[lid] = hash;
+  for (size_t stride = GROUP_SIZE / 2; stride > 0; stride /= 2) {
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid < stride) {
+      sums[lid] += sums[lid + stride];
+    }
+  }
+  if (lid == 0) {
+    group_sums[get_group_id(0)] = sums[0];
+  }
+}
@@ -0,0 +1,22 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+kernel void read_data(const global uint4 *src, global uint4 *sink) {
+  const size_t i = get_global_id(0);
+  sink[i & 255] = src[i];
+}
+
+kernel void write_data(global uint4 *dst, uint value) {
+  const size_t i = get_global_id(0);
+  dst[i] = (uint4)(value);
+}
+
+kernel void read_write_data(global uint4 *data) {
+  const size_t i = get_global_id(0);
+  data[i] = data[i] + (uint4)(1);
+}
@@ -121,6 +121,24 @@ void ZeApp::memoryAllocHost(size_t size, void **ptr) {
   SUCCESS_OR_TERMINATE(zeMemAllocHost(context, &host_desc, size, 1, ptr));
 }
 
+void ZeApp::memoryAllocShared(const uint32_t device_index, size_t size,
+                              void **ptr) {
+
+  ze_device_mem_alloc_desc_t device_desc = {};
+  device_desc.stype = ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC;
+  device_desc.pNext = nullptr;
+  device_desc.ordinal = 0;
+  device_desc.flags = 0;
+
+  ze_host_mem_alloc_desc_t host_desc = {};
+  host_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+  host_desc.pNext = nullptr;
+  host_desc.flags = 0;
+
+  SUCCESS_OR_TERMINATE(zeMemAllocShared(context, &device_desc, &host_desc,
+                                        size, 1, _devices[device_index], ptr));
+}
+
 void ZeApp::memoryFree(const void *ptr) {
   SUCCESS_OR_TERMINATE(zeMemFree(context, const_cast<void *>(ptr)));
 }
@@ -139,6 +157,32 @@ void ZeApp::deviceGetCommandQueueGroupProperties(
       _devices[device_index], numQueueGroups, queueProperties));
 }
 
+// Returns the first queue group supporting compute, or with copy_only the
+// first group supporting copy but not compute. False if there is none.
+bool ZeApp::queueGroupOrdinal(const uint32_t device_index, bool copy_only,
+                              uint32_t *ordinal) {
+  uint32_t numQueueGroups = 0;
+  deviceGetCommandQueueGroupProperties(device_index, &numQueueGroups, nullptr);
+
+  std::vector<ze_command_queue_group_properties_t> queueProperties(
+      numQueueGroups, {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_GROUP_PROPERTIES,
+                       nullptr});
+  deviceGetCommandQueueGroupProperties(device_index, &numQueueGroups,
+                                       queueProperties.data());
+
+  for (uint32_t i = 0; i < numQueueGroups; i++) {
+    bool compute = (queueProperties[i].flags &
+                    ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) != 0;
+    bool copy = (queueProperties[i].flags &
+                 ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COPY) != 0;
+    if ((copy_only && copy && !compute) || (!copy_only && compute)) {
+      *ordinal = i;
+      return true;
+    }
+  }
+  return false;
+}
+
 void ZeApp::functionCreate(ze_kernel_handle_t *function,
                            const char *pFunctionName) {
   functionCreate(0, function, pFunctionName);
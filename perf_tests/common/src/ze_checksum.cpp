@@ -0,0 +1,171 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../include/ze_checksum.hpp"
+#include "../include/common.hpp"
+
+#include <algorithm>
+
+static const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t prime3 = 0x165667B19E3779F9ULL;
+static const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// xxHash64 style rounds and avalanche over little endian 64-bit words, the
+// last word is zero padded. Same hash as chunk_hash in ze_checksum.cl.
+static uint64_t chunk_hash(const uint8_t *data, size_t size, uint64_t index) {
+  uint64_t acc = prime5 + index * prime1 + size;
+  for (size_t i = 0; i < size; i += 8) {
+    uint64_t word = 0;
+    for (size_t b = 0; b < 8 && i + b < size; b++) {
+      word |= static_cast<uint64_t>(data[i + b]) << (8 * b);
+    }
+    acc ^= rotl(word * prime2, 31) * prime1;
+    acc = rotl(acc, 27) * prime1 + prime3;
+  }
+  acc ^= acc >> 33;
+  acc *= prime2;
+  acc ^= acc >> 29;
+  acc *= prime3;
+  acc ^= acc >> 32;
+  return acc;
+}
+
+ZeChecksum::ZeChecksum(ZeApp *app) : app(app) {
+  std::ifstream stream("ze_checksum.spv", std::ios::in | std::ios::binary);
+  if (!stream.good()) {
+    throw std::runtime_error("Failed to load ze_checksum.spv");
+  }
+  module_binary.assign(std::istreambuf_iterator<char>(stream),
+                       std::istreambuf_iterator<char>());
+}
+
+ZeChecksum::~ZeChecksum() {
+  for (auto &device : devices) {
+    if (device.second.command_list) {
+      app->commandListDestroy(device.second.command_list);
+    }
+    if (device.second.kernel) {
+      app->functionDestroy(device.second.kernel);
+    }
+    if (device.second.module) {
+      SUCCESS_OR_TERMINATE(zeModuleDestroy(device.second.module));
+    }
+  }
+  if (group_sums) {
+    app->memoryFree(group_sums);
+  }
+}
+
+uint64_t ZeChecksum::host(const void *ptr, size_t size) {
+  const uint8_t *data = static_cast<const uint8_t *>(ptr);
+  uint64_t sum = 0;
+  for (size_t begin = 0; begin < size; begin += checksum_chunk_size) {
+    sum += chunk_hash(data + begin, std::min(checksum_chunk_size, size - begin),
+                      begin / checksum_chunk_size);
+  }
+  return sum;
+}
+
+//---------------------------------------------------------------------
+// Checksum of size bytes at ptr, on the device which holds ptr for device
+// and shared allocations, and on the host for host allocations and system
+// memory.
+//---------------------------------------------------------------------
+uint64_t ZeChecksum::compute(const void *ptr, size_t size) {
+  ze_memory_allocation_properties_t properties = {
+      ZE_STRUCTURE_TYPE_MEMORY_ALLOCATION_PROPERTIES, nullptr};
+  ze_device_handle_t device = nullptr;
+  SUCCESS_OR_TERMINATE(
+      zeMemGetAllocProperties(app->context, ptr, &properties, &device));
+
+  if (properties.type != ZE_MEMORY_TYPE_DEVICE &&
+      properties.type != ZE_MEMORY_TYPE_SHARED) {
+    return host(ptr, size);
+  }
+  if (device == nullptr) {
+    device = app->_devices[0];
+  }
+
+  return device_checksum(device_state(device), ptr, size);
+}
+
+ZeChecksum::device_state_t &
+ZeChecksum::device_state(ze_device_handle_t device) {
+  auto found = devices.find(device);
+  if (found != devices.end()) {
+    return found->second;
+  }
+  device_state_t &state = devices[device];
+
+  ze_command_queue_desc_t command_queue_desc = {};
+  command_queue_desc.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+  command_queue_desc.ordinal = 0;
+  command_queue_desc.mode = ZE_COMMAND_QUEUE_MODE_SYNCHRONOUS;
+  SUCCESS_OR_TERMINATE(zeCommandListCreateImmediate(
+      app->context, device, &command_queue_desc, &state.command_list));
+
+  ze_module_desc_t module_desc = {};
+  module_desc.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
+  module_desc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+  module_desc.inputSize = module_binary.size();
+  module_desc.pInputModule = module_binary.data();
+  SUCCESS_OR_TERMINATE(zeModuleCreate(app->context, device, &module_desc,
+                                      &state.module, nullptr));
+
+  ze_kernel_desc_t kernel_desc = {};
+  kernel_desc.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
+  kernel_desc.pKernelName = "checksum";
+  SUCCESS_OR_TERMINATE(
+      zeKernelCreate(state.module, &kernel_desc, &state.kernel));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetGroupSize(state.kernel, checksum_group_size, 1, 1));
+  return state;
+}
+
+// One work-item per chunk, each work-group writes the sum of its chunk
+// hashes to group_sums in host memory, which are added up here.
+uint64_t ZeChecksum::device_checksum(device_state_t &state, const void *ptr,
+                                     size_t size) {
+  size_t chunks = (size + checksum_chunk_size - 1) / checksum_chunk_size;
+  size_t groups = (chunks + checksum_group_size - 1) / checksum_group_size;
+  if (groups == 0) {
+    return 0;
+  }
+  if (groups > group_sums_count) {
+    if (group_sums) {
+      app->memoryFree(group_sums);
+    }
+    void *buffer = nullptr;
+    app->memoryAllocHost(groups * sizeof(uint64_t), &buffer);
+    group_sums = static_cast<uint64_t *>(buffer);
+    group_sums_count = groups;
+  }
+
+  uint64_t buffer_size = size;
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetArgumentValue(state.kernel, 0, sizeof(ptr), &ptr));
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      state.kernel, 1, sizeof(buffer_size), &buffer_size));
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      state.kernel, 2, sizeof(group_sums), &group_sums));
+
+  ze_group_count_t group_count = {static_cast<uint32_t>(groups), 1, 1};
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      state.command_list, state.kernel, &group_count, nullptr, 0, nullptr));
+  SUCCESS_OR_TERMINATE(
+      zeCommandListHostSynchronize(state.command_list, UINT64_MAX));
+
+  uint64_t sum = 0;
+  for (size_t i = 0; i < groups; i++) {
+    sum += group_sums[i];
+  }
+  return sum;
+}
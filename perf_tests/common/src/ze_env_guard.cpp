@@ -0,0 +1,342 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../include/ze_env_guard.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+static const char *cpu_sysfs = "/sys/devices/system/cpu/";
+
+static std::string read_line(const std::string &path) {
+  std::ifstream stream(path);
+  std::string line;
+  std::getline(stream, line);
+  return line;
+}
+
+// Parses a sysfs CPU list such as "0-3,8,10-11"
+static std::vector<int> parse_cpu_list(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    int first = 0;
+    int last = 0;
+    int count = sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (count < 1) {
+      continue;
+    }
+    for (int cpu = first; cpu <= (count == 2 ? last : first); cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+static std::string join(const std::vector<std::string> &values) {
+  std::string result;
+  for (const auto &value : values) {
+    result += (result.empty() ? "" : ",") + value;
+  }
+  return result;
+}
+
+static std::string to_string(long double value, int precision) {
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(precision) << value;
+  return stream.str();
+}
+
+struct cpu_time_t {
+  unsigned long long busy = 0;
+  unsigned long long total = 0;
+};
+
+// Busy and total jiffies per CPU from /proc/stat, all CPUs under key -1
+static std::map<int, cpu_time_t> read_cpu_times(void) {
+  std::map<int, cpu_time_t> times;
+  std::ifstream stream("/proc/stat");
+  std::string line;
+  while (std::getline(stream, line) && line.compare(0, 3, "cpu") == 0) {
+    std::stringstream fields(line);
+    std::string name;
+    unsigned long long user = 0, nice = 0, system = 0, idle = 0, iowait = 0,
+                       irq = 0, softirq = 0, steal = 0;
+    fields >> name >> user >> nice >> system >> idle >> iowait >> irq >>
+        softirq >> steal;
+    int cpu = name == "cpu" ? -1 : std::stoi(name.substr(3));
+    times[cpu].busy = user + nice + system + irq + softirq + steal;
+    times[cpu].total = times[cpu].busy + idle + iowait;
+  }
+  return times;
+}
+
+static long double busy_fraction(const cpu_time_t &before,
+                                 const cpu_time_t &after) {
+  if (after.total <= before.total) {
+    return 0;
+  }
+  return static_cast<long double>(after.busy - before.busy) /
+         static_cast<long double>(after.total - before.total);
+}
+
+bool ZeEnvGuard::parse_governor_policy(const std::string &policy) {
+  if (policy == "ignore") {
+    governor_policy = GOVERNOR_IGNORE;
+  } else if (policy == "warn") {
+    governor_policy = GOVERNOR_WARN;
+  } else if (policy == "refuse") {
+    governor_policy = GOVERNOR_REFUSE;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char *ZeEnvGuard::governor_policy_name(governor_policy_t policy) {
+  switch (policy) {
+  case GOVERNOR_IGNORE:
+    return "ignore";
+  case GOVERNOR_REFUSE:
+    return "refuse";
+  default:
+    return "warn";
+  }
+}
+
+void ZeEnvGuard::record(const std::string &key, const std::string &value) {
+  metadata.push_back(std::make_pair(key, value));
+}
+
+bool ZeEnvGuard::apply(ze_device_handle_t device) {
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(static_cast<size_t>(cpu), &allowed)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (pin_cpu) {
+    pin_to_device_node(device);
+  } else {
+    record("Pinned CPU", "none");
+  }
+  check_turbo();
+  if (!check_governor()) {
+    return false;
+  }
+  if (noise_msec > 0) {
+    measure_noise();
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------
+// Pins the calling thread to a CPU on the NUMA node of the device, from the
+// local_cpulist of its PCI function, or to one of the allowed CPUs if the
+// device location is not known. CPU 0 is avoided when possible as it often
+// services most interrupts.
+//---------------------------------------------------------------------
+void ZeEnvGuard::pin_to_device_node(ze_device_handle_t device) {
+  std::vector<int> local_cpus;
+#ifdef ZE_PCI_PROPERTIES_EXT_NAME
+  ze_pci_ext_properties_t pci_properties = {
+      ZE_STRUCTURE_TYPE_PCI_EXT_PROPERTIES, nullptr};
+  if (zeDevicePciGetPropertiesExt(device, &pci_properties) ==
+      ZE_RESULT_SUCCESS) {
+    char address[32];
+    snprintf(address, sizeof(address), "%04x:%02x:%02x.%x",
+             pci_properties.address.domain, pci_properties.address.bus,
+             pci_properties.address.device, pci_properties.address.function);
+    std::string path = std::string("/sys/bus/pci/devices/") + address;
+    std::string numa_node = read_line(path + "/numa_node");
+    record("PCI address", address);
+    record("NUMA node", numa_node.empty() ? "unknown" : numa_node);
+    local_cpus = parse_cpu_list(read_line(path + "/local_cpulist"));
+  }
+#else
+  (void)device;
+#endif
+
+  std::vector<int> candidates;
+  for (int cpu : cpus) {
+    if (local_cpus.empty() || std::find(local_cpus.begin(), local_cpus.end(),
+                                        cpu) != local_cpus.end()) {
+      candidates.push_back(cpu);
+    }
+  }
+  if (candidates.size() > 1 && candidates[0] == 0) {
+    candidates.erase(candidates.begin());
+  }
+
+#ifdef __linux__
+  if (!candidates.empty()) {
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(static_cast<size_t>(candidates[0]), &pinned);
+    if (sched_setaffinity(0, sizeof(pinned), &pinned) == 0) {
+      cpus = {candidates[0]};
+      record("Pinned CPU", std::to_string(candidates[0]));
+      return;
+    }
+  }
+#endif
+  std::cerr << "WARNING: submitting thread could not be pinned" << std::endl;
+  record("Pinned CPU", "none");
+}
+
+// Governors of the CPUs the thread may run on, a governor other than
+// performance lets the clock ramp with the load and skews short runs.
+bool ZeEnvGuard::check_governor(void) {
+  std::set<std::string> governors;
+  for (int cpu : cpus) {
+    std::string governor =
+        read_line(cpu_sysfs + ("cpu" + std::to_string(cpu)) +
+                  "/cpufreq/scaling_governor");
+    if (!governor.empty()) {
+      governors.insert(governor);
+    }
+  }
+  if (governors.empty()) {
+    record("CPU governor", "unknown");
+    return true;
+  }
+  record("CPU governor",
+         join(std::vector<std::string>(governors.begin(), governors.end())));
+
+  if (governors.size() == 1 && *governors.begin() == "performance") {
+    return true;
+  }
+  if (governor_policy == GOVERNOR_REFUSE) {
+    std::cerr << "ERROR: CPU governor is " << metadata.back().second
+              << ", not performance" << std::endl;
+    return false;
+  }
+  if (governor_policy == GOVERNOR_WARN) {
+    std::cerr << "WARNING: CPU governor is " << metadata.back().second
+              << ", not performance" << std::endl;
+  }
+  return true;
+}
+
+void ZeEnvGuard::check_turbo(void) {
+  std::string no_turbo =
+      read_line(std::string(cpu_sysfs) + "intel_pstate/no_turbo");
+  std::string boost = read_line(std::string(cpu_sysfs) + "cpufreq/boost");
+  if (no_turbo == "0" || boost == "1") {
+    record("Turbo", "enabled");
+  } else if (no_turbo == "1" || boost == "0") {
+    record("Turbo", "disabled");
+  } else {
+    record("Turbo", "unknown");
+  }
+}
+
+//---------------------------------------------------------------------
+// Spins for noise_msec reading the clock, and counts as interruptions the
+// gaps between two reads longer than 5 usec, when the thread was
+// descheduled or serviced an interrupt. The CPU time of the other CPUs and
+// of the SMT siblings of the pinned CPU over the same window is taken
+// from /proc/stat.
+//---------------------------------------------------------------------
+void ZeEnvGuard::measure_noise(void) {
+  const auto window = std::chrono::milliseconds(noise_msec);
+  const auto threshold = std::chrono::microseconds(5);
+  std::chrono::steady_clock::duration lost(0);
+  std::chrono::steady_clock::duration longest(0);
+  uint32_t interruptions = 0;
+
+  std::map<int, cpu_time_t> before = read_cpu_times();
+  auto start = std::chrono::steady_clock::now();
+  auto last = start;
+  auto now = start;
+  while (now - start < window) {
+    now = std::chrono::steady_clock::now();
+    auto gap = now - last;
+    if (gap > threshold) {
+      lost += gap;
+      longest = std::max(longest, gap);
+      interruptions++;
+    }
+    last = now;
+  }
+  std::map<int, cpu_time_t> after = read_cpu_times();
+
+  long double lost_percent =
+      100.0L * std::chrono::duration<long double>(lost).count() /
+      std::chrono::duration<long double>(now - start).count();
+  record("Noise time lost (%)", to_string(lost_percent, 3));
+  record("Noise interruptions", std::to_string(interruptions));
+  record("Noise longest interruption (usec)",
+         to_string(std::chrono::duration<long double, std::micro>(longest)
+                       .count(),
+                   1));
+
+  long double background = -1; /* the spinning thread itself */
+  for (const auto &cpu : after) {
+    if (cpu.first >= 0 && before.count(cpu.first)) {
+      background += busy_fraction(before[cpu.first], cpu.second);
+    }
+  }
+  background = std::max(background, 0.0L);
+  record("Background load (CPUs)", to_string(background, 2));
+
+  if (cpus.size() == 1) {
+    std::string siblings =
+        read_line(cpu_sysfs + ("cpu" + std::to_string(cpus[0])) +
+                  "/topology/thread_siblings_list");
+    long double sibling_busy = 0;
+    for (int sibling : parse_cpu_list(siblings)) {
+      if (sibling != cpus[0] && before.count(sibling) && after.count(sibling)) {
+        sibling_busy = std::max(
+            sibling_busy, busy_fraction(before[sibling], after[sibling]));
+      }
+    }
+    record("SMT sibling busy (%)", to_string(100 * sibling_busy, 1));
+  }
+  std::string load_average;
+  std::stringstream(read_line("/proc/loadavg")) >> load_average;
+  record("Load average", load_average.empty() ? "unknown" : load_average);
+
+  if (lost_percent > 1 || background >= 0.5) {
+    std::cerr << "WARNING: host noise detected, " << to_string(lost_percent, 2)
+              << "% of the time lost to interruptions, "
+              << to_string(background, 2) << " other CPUs busy" << std::endl;
+  }
+}
+
+bool ZeEnvGuard::setup(ze_device_handle_t device) {
+  if (!apply(device)) {
+    return false;
+  }
+  print();
+  return true;
+}
+
+void ZeEnvGuard::print(void) const {
+  std::cout << "Environment:" << std::endl;
+  for (const auto &entry : metadata) {
+    std::cout << "  " << entry.first << ": " << entry.second << std::endl;
+  }
+}
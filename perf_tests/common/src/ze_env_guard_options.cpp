@@ -0,0 +1,38 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../include/ze_env_guard.hpp"
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+po::options_description ZeEnvGuard::options(void) {
+  po::options_description desc("Host environment options");
+  desc.add_options()(
+      "pin-cpu", po::bool_switch(&pin_cpu),
+      "pin the submitting thread to a CPU on the NUMA node of the device, "
+      "threads and processes it starts run on that CPU too")(
+      "governor",
+      po::value<std::string>()
+          ->default_value(governor_policy_name(governor_policy))
+          ->notifier([this](const std::string &policy) {
+            if (!parse_governor_policy(policy)) {
+              throw po::validation_error(
+                  po::validation_error::invalid_option_value, "governor",
+                  policy);
+            }
+          }),
+      "ignore, warn or refuse to run when the CPU governor is not "
+      "performance")(
+      "noise-msec",
+      po::value<uint32_t>(&noise_msec)->default_value(noise_msec),
+      "set duration of the host noise measurement before the run, 0 to "
+      "skip");
+  return desc;
+}
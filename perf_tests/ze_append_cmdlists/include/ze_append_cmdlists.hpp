@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_APPEND_CMDLISTS_HPP
+#define ZE_APPEND_CMDLISTS_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum submission_path_t {
+  REGULAR_LIST = 0,          /* zeCommandQueueExecuteCommandLists */
+  IMMEDIATE_DIRECT = 1,      /* appends directly on an immediate list */
+  IMMEDIATE_APPEND_LISTS = 2 /* zeCommandListImmediateAppendCommandListsExp */
+};
+
+struct submission_latency_t {
+  long double host_usec = 0;       /* time spent in the submission calls */
+  long double end_to_end_usec = 0; /* submission until completion on host */
+};
+
+class ZeAppendCmdlists {
+public:
+  ZeAppendCmdlists();
+  ~ZeAppendCmdlists();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<uint32_t> list_sizes;
+  uint32_t min_list_size = 1;
+  uint32_t max_list_size = 10000;
+  uint32_t number_iterations = 100;
+  uint32_t warmup_iterations = 5;
+  uint32_t command_queue_group_ordinal = 0;
+  bool run_without_events = true;
+  bool run_with_events = true;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  void record_list(ze_command_list_handle_t command_list, uint32_t list_size,
+                   bool use_events);
+  void append_kernels(ze_command_list_handle_t command_list,
+                      uint32_t list_size, bool use_events);
+  void prepare_events(bool use_events);
+  void wait_for_completion(submission_path_t path, bool use_events);
+  bool submit(submission_path_t path, uint32_t list_size, bool use_events);
+  bool measure(submission_path_t path, uint32_t list_size, bool use_events,
+               submission_latency_t &latency);
+  void report(submission_path_t path, uint32_t list_size, bool use_events,
+              const submission_latency_t &latency);
+
+  ZeApp *benchmark;
+  ze_kernel_handle_t kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+  ze_command_list_handle_t immediate_command_list = nullptr;
+  ze_event_pool_handle_t event_pool = nullptr;
+  ze_event_handle_t wait_event = nullptr;
+  ze_event_handle_t signal_event = nullptr;
+  bool append_lists_supported = true;
+};
+
+#endif /* ZE_APPEND_CMDLISTS_HPP */
@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_append_cmdlists.hpp"
+
+int ZeAppendCmdlists::parse_command_line(int argc, char **argv) {
+
+  std::string events = "all";
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "min-list-size",
+        po::value<uint32_t>(&min_list_size)->default_value(1),
+        "set smallest number of kernels recorded in a command list")(
+        "max-list-size",
+        po::value<uint32_t>(&max_list_size)->default_value(10000),
+        "set largest number of kernels recorded in a command list")(
+        "warmup", po::value<uint32_t>(&warmup_iterations)->default_value(5),
+        "set number of warmup operations")(
+        "num-iter",
+        po::value<uint32_t>(&number_iterations)->default_value(100),
+        "set number of iterations")(
+        "ordinal",
+            po::value<uint32_t>(&command_queue_group_ordinal)
+                ->default_value(0),
+            "set command queue group ordinal used for all submissions")(
+        "events", po::value<std::string>(&events)->default_value("all"),
+        "submit without events (none), with a wait and a signal event "
+        "(wait-signal) or both (all)")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  if (events == "none") {
+    run_without_events = true;
+    run_with_events = false;
+  } else if (events == "wait-signal") {
+    run_without_events = false;
+    run_with_events = true;
+  } else if (events == "all") {
+    run_without_events = true;
+    run_with_events = true;
+  } else {
+    std::cout << "unknown events mode " << events << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  if (min_list_size == 0 || min_list_size > max_list_size) {
+    std::cout << "invalid list size range" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  if (number_iterations == 0) {
+    std::cout << "number of iterations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  // List sizes grow by a factor of ten: 1, 10, 100, 1000, 10000 by default.
+  list_sizes.clear();
+  for (uint64_t size = min_list_size; size < max_list_size; size *= 10) {
+    list_sizes.push_back(static_cast<uint32_t>(size));
+  }
+  list_sizes.push_back(max_list_size);
+
+  return 0;
+}
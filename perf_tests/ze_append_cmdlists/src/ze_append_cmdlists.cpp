@@ -0,0 +1,254 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_append_cmdlists.hpp"
+
+static const char *path_names[] = {"regular list + queue",
+                                   "immediate direct appends",
+                                   "immediate append of lists"};
+
+ZeAppendCmdlists::ZeAppendCmdlists() {
+  benchmark = new ZeApp("ze_empty_kernel.spv");
+  benchmark->singleDeviceInit();
+
+  benchmark->functionCreate(&kernel, "empty_kernel");
+  SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, 1, 1, 1));
+
+  event_pool = benchmark->create_event_pool(2, ZE_EVENT_POOL_FLAG_HOST_VISIBLE);
+  benchmark->create_event(event_pool, wait_event, 0);
+  benchmark->create_event(event_pool, signal_event, 1);
+}
+
+ZeAppendCmdlists::~ZeAppendCmdlists() {
+  benchmark->destroy_event(wait_event);
+  benchmark->destroy_event(signal_event);
+  benchmark->destroy_event_pool(event_pool);
+  benchmark->functionDestroy(kernel);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeAppendCmdlists::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeAppendCmdlists::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+// Appends list_size empty kernels. With events, the first kernel waits on
+// wait_event and the last kernel signals signal_event.
+void ZeAppendCmdlists::append_kernels(ze_command_list_handle_t command_list,
+                                      uint32_t list_size, bool use_events) {
+  const ze_group_count_t group_count = {1, 1, 1};
+
+  for (uint32_t i = 0U; i < list_size; i++) {
+    bool first = (i == 0);
+    bool last = (i == list_size - 1);
+    ze_event_handle_t signal = (use_events && last) ? signal_event : nullptr;
+    uint32_t num_wait = (use_events && first) ? 1 : 0;
+    ze_event_handle_t *wait = (use_events && first) ? &wait_event : nullptr;
+
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        command_list, kernel, &group_count, signal, num_wait, wait));
+  }
+}
+
+void ZeAppendCmdlists::record_list(ze_command_list_handle_t command_list,
+                                   uint32_t list_size, bool use_events) {
+  benchmark->commandListReset(command_list);
+  append_kernels(command_list, list_size, use_events);
+  benchmark->commandListClose(command_list);
+}
+
+// Events are reset and the wait event is signaled from the host outside of
+// the timed region, so only the cost of the dependency check is measured.
+void ZeAppendCmdlists::prepare_events(bool use_events) {
+  if (!use_events) {
+    return;
+  }
+  SUCCESS_OR_TERMINATE(zeEventHostReset(signal_event));
+  SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
+  SUCCESS_OR_TERMINATE(zeEventHostSignal(wait_event));
+}
+
+bool ZeAppendCmdlists::submit(submission_path_t path, uint32_t list_size,
+                              bool use_events) {
+  switch (path) {
+  case REGULAR_LIST:
+    SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+        command_queue, 1, &command_list, nullptr));
+    break;
+  case IMMEDIATE_DIRECT:
+    append_kernels(immediate_command_list, list_size, use_events);
+    break;
+  case IMMEDIATE_APPEND_LISTS: {
+    ze_result_t result = zeCommandListImmediateAppendCommandListsExp(
+        immediate_command_list, 1, &command_list,
+        use_events ? signal_event : nullptr, use_events ? 1 : 0,
+        use_events ? &wait_event : nullptr);
+    if (result != ZE_RESULT_SUCCESS) {
+      std::cerr << "WARNING : zeCommandListImmediateAppendCommandListsExp : "
+                << result << std::endl;
+      return false;
+    }
+    break;
+  }
+  }
+  return true;
+}
+
+void ZeAppendCmdlists::wait_for_completion(submission_path_t path,
+                                           bool use_events) {
+  if (use_events) {
+    SUCCESS_OR_TERMINATE(zeEventHostSynchronize(signal_event, UINT64_MAX));
+  } else if (path == REGULAR_LIST) {
+    SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+  } else {
+    SUCCESS_OR_TERMINATE(
+        zeCommandListHostSynchronize(immediate_command_list, UINT64_MAX));
+  }
+}
+
+bool ZeAppendCmdlists::measure(submission_path_t path, uint32_t list_size,
+                               bool use_events,
+                               submission_latency_t &latency) {
+  Timer<std::chrono::microseconds::period> timer;
+  long double host_usec = 0;
+  long double end_to_end_usec = 0;
+
+  if (path == REGULAR_LIST) {
+    record_list(command_list, list_size, use_events);
+  } else if (path == IMMEDIATE_APPEND_LISTS) {
+    // Events are passed to the append call instead of being recorded.
+    record_list(command_list, list_size, false);
+  }
+
+  for (uint32_t i = 0U; i < warmup_iterations; i++) {
+    prepare_events(use_events);
+    if (!submit(path, list_size, use_events)) {
+      return false;
+    }
+    wait_for_completion(path, use_events);
+  }
+
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    prepare_events(use_events);
+
+    timer.start();
+    if (!submit(path, list_size, use_events)) {
+      return false;
+    }
+    timer.end();
+    host_usec += timer.period_minus_overhead();
+
+    wait_for_completion(path, use_events);
+    timer.end();
+    end_to_end_usec += timer.period_minus_overhead();
+  }
+
+  latency.host_usec = host_usec / number_iterations;
+  latency.end_to_end_usec = end_to_end_usec / number_iterations;
+  return true;
+}
+
+void ZeAppendCmdlists::report(submission_path_t path, uint32_t list_size,
+                              bool use_events,
+                              const submission_latency_t &latency) {
+  std::cout << std::left << std::setw(27) << path_names[path] << std::right
+            << " list size " << std::setw(6) << list_size << "  events "
+            << (use_events ? "yes" : "no ") << std::fixed
+            << std::setprecision(2) << " :  host = " << std::setw(10)
+            << latency.host_usec << " usec  e2e = " << std::setw(10)
+            << latency.end_to_end_usec << " usec  (per kernel: host = "
+            << std::setprecision(3) << latency.host_usec / list_size
+            << " usec  e2e = " << latency.end_to_end_usec / list_size
+            << " usec)" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", path_names[path]);
+      test_ptree.put("List size", list_size);
+      test_ptree.put("Events", use_events ? "wait-signal" : "none");
+      test_ptree.put("Host latency(usec)", latency.host_usec);
+      test_ptree.put("End to end latency(usec)", latency.end_to_end_usec);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting append command lists measurement: "
+                << e.what() << std::endl;
+    }
+  }
+}
+
+void ZeAppendCmdlists::run(void) {
+  benchmark->commandQueueCreate(0, command_queue_group_ordinal,
+                                &command_queue);
+  benchmark->commandListCreate(0, command_queue_group_ordinal, &command_list);
+  benchmark->immediateCommandListCreate(0, command_queue_group_ordinal, 0,
+                                        &immediate_command_list);
+
+  std::vector<bool> event_modes;
+  if (run_without_events) {
+    event_modes.push_back(false);
+  }
+  if (run_with_events) {
+    event_modes.push_back(true);
+  }
+
+  for (uint32_t list_size : list_sizes) {
+    for (bool use_events : event_modes) {
+      for (submission_path_t path :
+           {REGULAR_LIST, IMMEDIATE_DIRECT, IMMEDIATE_APPEND_LISTS}) {
+        if (path == IMMEDIATE_APPEND_LISTS && !append_lists_supported) {
+          continue;
+        }
+        submission_latency_t latency;
+        if (!measure(path, list_size, use_events, latency)) {
+          std::cout << path_names[path]
+                    << ": not supported by the driver, skipping" << std::endl;
+          append_lists_supported = false;
+          continue;
+        }
+        report(path, list_size, use_events, latency);
+      }
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->commandListDestroy(immediate_command_list);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.append_cmdlists",
+                           param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeAppendCmdlists append_cmdlists;
+  SUCCESS_OR_TERMINATE(append_cmdlists.parse_command_line(argc, argv));
+  if (!append_cmdlists.setup_environment()) {
+    return 1;
+  }
+  append_cmdlists.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
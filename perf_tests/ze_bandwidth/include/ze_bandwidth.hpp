@@ -7,8 +7,16 @@
  */
 
 #include <chrono>
+#include <map>
 #include <level_zero/ze_api.h>
 #include "ze_app.hpp"
+#include "ze_checksum.hpp"
+#include "ze_env_guard.hpp"
+
+struct host_allocation_t {
+  void *system_ptr;   /* malloc, mmap or imported memory, nullptr for USM */
+  size_t mapped_size; /* size of mmap memory */
+};
 
 class ZeBandwidth {
 public:
@@ -19,6 +27,7 @@ public:
   void test_device2host(void);
   void test_bidir(void);
   void ze_bandwidth_query_engines();
+  bool host_memory_supported(void);
 
   std::vector<size_t> transfer_size;
   std::vector<uint32_t> device_ids{};
@@ -38,6 +47,10 @@ public:
   uint32_t command_queue_group_ordinal1 = 0;
   uint32_t command_queue_index1 = 0;
   bool csv_output = false;
+  std::vector<std::string> host_memory_kinds = {"usm"};
+  std::string host_memory = "usm";
+  bool report_host_memory = false;
+  ZeEnvGuard env_guard{GOVERNOR_IGNORE, 0};
   ze_event_pool_handle_t event_pool = {};
   ze_event_handle_t wait_event = {};
 
@@ -75,11 +88,23 @@ private:
                          long double total_data_transfer, /* Units in bytes */
                          long double &total_bandwidth,
                          long double &total_latency);
+  void host_memory_alloc(size_t size, void **ptr);
+  void host_memory_free(void *ptr);
+  void reset_host_memory_cost(void);
+  void print_host_memory_cost(void);
+  uint32_t verify_transfer(std::vector<void *> &destination_buffer,
+                           size_t buffer_size, uint64_t expected_checksum);
 
   ze_command_queue_handle_t command_queue_verify{};
   ze_command_list_handle_t command_list_verify{};
+  ZeChecksum *checksum = nullptr;
   std::vector<ze_command_queue_group_properties_t> queueProperties;
 
-  void *host_buffer_verify;
   void *host_buffer_verify1;
+
+  std::map<void *, host_allocation_t> host_allocations;
+  uint32_t host_alloc_count = 0;
+  long double host_alloc_nsec = 0;
+  long double host_touch_nsec = 0;
+  long double first_copy_nsec = 0;
 };
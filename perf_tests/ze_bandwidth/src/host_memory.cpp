@@ -0,0 +1,187 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../../common/include/common.hpp"
+#include "ze_app.hpp"
+#include "ze_bandwidth.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static ze_host_mem_alloc_flags_t usm_flags(const std::string &kind) {
+  if (kind == "usm_cached") {
+    return ZE_HOST_MEM_ALLOC_FLAG_BIAS_CACHED;
+  } else if (kind == "usm_uncached") {
+    return ZE_HOST_MEM_ALLOC_FLAG_BIAS_UNCACHED;
+  } else if (kind == "usm_wc") {
+    return ZE_HOST_MEM_ALLOC_FLAG_BIAS_WRITE_COMBINED;
+  }
+  return 0;
+}
+
+#ifdef __linux__
+// Anonymous mapping of size rounded up to the page size, backed by huge
+// pages of 2^page_shift bytes if page_shift is not 0. Returns nullptr if
+// the mapping fails, for instance when no huge pages are reserved.
+static void *map_host_memory(size_t size, int page_shift,
+                             size_t *mapped_size) {
+  size_t page_size = page_shift ? size_t(1) << page_shift
+                                : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  if (page_shift) {
+    flags |= MAP_HUGETLB | (page_shift << MAP_HUGE_SHIFT);
+  }
+  *mapped_size = (size + page_size - 1) / page_size * page_size;
+  void *ptr =
+      mmap(nullptr, *mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+#endif
+
+//---------------------------------------------------------------------
+// Allocates a host buffer of the kind selected with --host-mem:
+//   usm, usm_cached, usm_uncached, usm_wc: zeMemAllocHost with no flag or
+//     the cached, uncached or write-combined bias flag
+//   malloc: pageable memory from malloc
+//   hugepage_2m, hugepage_1g: mmap backed by 2 MB or 1 GB huge pages
+//   import: page aligned mmap memory imported with the external memmap
+//     sysmem extension
+// The time to obtain the buffer, registration included, and the time to
+// write every byte of it once are accumulated for print_host_memory_cost.
+// Throws if the kind is not available, see host_memory_supported.
+//---------------------------------------------------------------------
+void ZeBandwidth::host_memory_alloc(size_t size, void **ptr) {
+  host_allocation_t allocation = {nullptr, 0};
+  ze_result_t result = ZE_RESULT_SUCCESS;
+  Timer<std::chrono::nanoseconds::period> timer;
+
+  *ptr = nullptr;
+  timer.start();
+  if (host_memory.compare(0, 3, "usm") == 0) {
+    ze_host_mem_alloc_desc_t host_desc = {};
+    host_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+    host_desc.pNext = nullptr;
+    host_desc.flags = usm_flags(host_memory);
+    result = zeMemAllocHost(benchmark->context, &host_desc, size, 1, ptr);
+  } else if (host_memory == "malloc") {
+    *ptr = malloc(size);
+    allocation.system_ptr = *ptr;
+#ifdef __linux__
+  } else if (host_memory == "hugepage_2m" || host_memory == "hugepage_1g") {
+    *ptr = map_host_memory(size, host_memory == "hugepage_2m" ? 21 : 30,
+                           &allocation.mapped_size);
+    allocation.system_ptr = *ptr;
+#ifdef ZE_EXTERNAL_MEMMAP_SYSMEM_EXT_NAME
+  } else if (host_memory == "import") {
+    allocation.system_ptr = map_host_memory(size, 0, &allocation.mapped_size);
+    if (allocation.system_ptr != nullptr) {
+      ze_external_memmap_sysmem_ext_desc_t sysmem_desc = {};
+      sysmem_desc.stype = ZE_STRUCTURE_TYPE_EXTERNAL_MEMMAP_SYSMEM_EXT_DESC;
+      sysmem_desc.pSystemMemory = allocation.system_ptr;
+      sysmem_desc.size = allocation.mapped_size;
+      ze_host_mem_alloc_desc_t host_desc = {};
+      host_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+      host_desc.pNext = &sysmem_desc;
+      result = zeMemAllocHost(benchmark->context, &host_desc,
+                              allocation.mapped_size, 1, ptr);
+      if (result != ZE_RESULT_SUCCESS) {
+        munmap(allocation.system_ptr, allocation.mapped_size);
+      }
+    }
+#endif
+#endif
+  }
+  timer.end();
+
+  if (result != ZE_RESULT_SUCCESS || *ptr == nullptr) {
+    throw std::runtime_error("Host memory " + host_memory +
+                             " allocation failed: " + std::to_string(result));
+  }
+  host_alloc_nsec += timer.period_minus_overhead();
+
+  timer.start();
+  memset(*ptr, 1, size);
+  timer.end();
+  host_touch_nsec += timer.period_minus_overhead();
+
+  host_alloc_count++;
+  host_allocations[*ptr] = allocation;
+}
+
+// Frees a buffer of host_memory_alloc the way its kind was allocated: USM
+// and imported memory through the driver, then the mapping behind imported
+// and huge page memory.
+void ZeBandwidth::host_memory_free(void *ptr) {
+  host_allocation_t allocation = host_allocations[ptr];
+  host_allocations.erase(ptr);
+
+  if (host_memory == "malloc") {
+    free(ptr);
+    return;
+  }
+  if (host_memory.compare(0, 3, "usm") == 0 || host_memory == "import") {
+    benchmark->memoryFree(ptr);
+  }
+#ifdef __linux__
+  if (allocation.mapped_size) {
+    munmap(allocation.system_ptr, allocation.mapped_size);
+  }
+#endif
+}
+
+//---------------------------------------------------------------------
+// Whether a buffer of the selected host memory kind can be allocated, so
+// that unavailable kinds, such as huge pages with none reserved or import
+// without driver support, are reported and skipped.
+//---------------------------------------------------------------------
+bool ZeBandwidth::host_memory_supported(void) {
+  void *ptr = nullptr;
+  try {
+    host_memory_alloc(1, &ptr);
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+  host_memory_free(ptr);
+  return true;
+}
+
+void ZeBandwidth::reset_host_memory_cost(void) {
+  host_alloc_count = 0;
+  host_alloc_nsec = 0;
+  host_touch_nsec = 0;
+  first_copy_nsec = 0;
+}
+
+// Allocation and first touch time per buffer, and the time of the first
+// transfer of the buffers, which is the first warmup iteration, or the
+// first timed one when there is no warmup.
+void ZeBandwidth::print_host_memory_cost(void) {
+  long double alloc_usec =
+      host_alloc_count ? host_alloc_nsec / host_alloc_count / 1e3 : 0;
+  long double touch_usec =
+      host_alloc_count ? host_touch_nsec / host_alloc_count / 1e3 : 0;
+  long double first_copy_usec = first_copy_nsec / 1e3;
+
+  if (csv_output) {
+    std::cout << host_memory << "," << std::setprecision(2) << alloc_usec
+              << "," << touch_usec << "," << first_copy_usec << std::endl;
+  } else {
+    std::cout << "[Host mem " << std::left << std::setw(12) << host_memory
+              << std::right << "]:  Alloc = " << std::fixed << std::setw(9)
+              << std::setprecision(2) << alloc_usec
+              << " usec  First touch = " << std::setw(9) << touch_usec
+              << " usec  First copy = " << std::setw(9) << first_copy_usec
+              << " usec" << std::endl;
+  }
+}
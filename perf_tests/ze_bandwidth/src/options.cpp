@@ -8,6 +8,9 @@
 
 #include "ze_bandwidth.hpp"
 
+#include <algorithm>
+#include <sstream>
+
 static const char *usage_str =
     "\n ze_bandwidth [OPTIONS]"
     "\n"
@@ -43,6 +46,31 @@ static const char *usage_str =
     "\n  --immediate              use immediate command lists (default: "
     "disabled)"
     "\n  --csv                    output in csv format (default: disabled)"
+    "\n  --host-mem list          comma separated host memory kinds to "
+    "measure,"
+    "\n                            with allocation, first touch and first "
+    "copy"
+    "\n                            cost (default: usm):"
+    "\n      usm                              zeMemAllocHost without flags"
+    "\n      usm_cached                       zeMemAllocHost, cached bias"
+    "\n      usm_uncached                     zeMemAllocHost, uncached bias"
+    "\n      usm_wc                           zeMemAllocHost, write-combined "
+    "bias"
+    "\n      malloc                           pageable malloc memory"
+    "\n      hugepage_2m                      mmap with 2 MB huge pages"
+    "\n      hugepage_1g                      mmap with 1 GB huge pages"
+    "\n      import                           mmap memory imported with "
+    "zeMemAllocHost"
+    "\n      all                              all of the above"
+    "\n  --pin-cpu                pin the submitting thread to a CPU on the "
+    "NUMA"
+    "\n                            node of the first device (default: "
+    "disabled)"
+    "\n  --governor policy        ignore, warn or refuse to run when the CPU"
+    "\n                            governor is not performance (default: "
+    "ignore)"
+    "\n  --noise-msec             set duration of the host noise measurement"
+    "\n                            before the run, 0 to skip [default:  0]"
     "\n  -h, --help               display help message"
     "\n";
 
@@ -139,8 +167,45 @@ int ZeBandwidth::parse_arguments(int argc, char **argv) {
       i++;
     } else if ((strcmp(argv[i], "--csv") == 0)) {
       csv_output = true;
+    } else if ((strcmp(argv[i], "--host-mem") == 0)) {
+      static const std::vector<std::string> kinds = {
+          "usm",    "usm_cached",  "usm_uncached", "usm_wc",
+          "malloc", "hugepage_2m", "hugepage_1g",  "import"};
+      if ((i + 1) >= argc) {
+        std::cout << usage_str;
+        exit(-1);
+      }
+      std::stringstream list(argv[i + 1]);
+      std::string kind;
+      host_memory_kinds.clear();
+      while (std::getline(list, kind, ',')) {
+        if (kind == "all") {
+          host_memory_kinds = kinds;
+        } else if (std::find(kinds.begin(), kinds.end(), kind) !=
+                   kinds.end()) {
+          host_memory_kinds.push_back(kind);
+        } else {
+          std::cout << usage_str;
+          exit(-1);
+        }
+      }
+      report_host_memory = true;
+      i++;
     } else if ((strcmp(argv[i], "--immediate") == 0)) {
       use_immediate_command_list = true;
+    } else if ((strcmp(argv[i], "--pin-cpu") == 0)) {
+      env_guard.pin_cpu = true;
+    } else if ((strcmp(argv[i], "--governor") == 0)) {
+      if ((i + 1) >= argc || !env_guard.parse_governor_policy(argv[i + 1])) {
+        std::cout << usage_str;
+        exit(-1);
+      }
+      i++;
+    } else if ((strcmp(argv[i], "--noise-msec") == 0)) {
+      if ((i + 1) < argc) {
+        env_guard.noise_msec = sanitize_ulong(argv[i + 1]);
+        i++;
+      }
     } else if ((strcmp(argv[i], "-n") == 0)) {
       enable_fixed_ordinal_index = true;
       std::string queues_string = argv[i + 1];
@@ -30,6 +30,7 @@ ZeBandwidth::~ZeBandwidth() {
     if (command_queue_verify) {
       benchmark->commandQueueDestroy(command_queue_verify);
     }
+    delete checksum;
     for (auto device_id : device_ids) {
       if (command_list[device_id]) {
         benchmark->commandListDestroy(command_list[device_id]);
@@ -88,6 +89,10 @@ void ZeBandwidth::transfer_size_test(
     std::vector<long double> &device_times_nsec, long double &total_time_nsec) {
   size_t element_size = sizeof(uint8_t);
   size_t buffer_size = element_size * size;
+  uint64_t expected_checksum = 0;
+  uint32_t number_of_errors = 0;
+  long double verify_time_nsec = 0;
+  Timer<std::chrono::nanoseconds::period> verify_timer;
 
   if (verify) {
     benchmark->memoryAllocHost(buffer_size, &host_buffer_verify1);
@@ -95,6 +100,7 @@ void ZeBandwidth::transfer_size_test(
     for (uint32_t i = 0; i < buffer_size; i++) {
       host_buffer_verify_char1[i] = static_cast<char>(i);
     }
+    expected_checksum = ZeChecksum::host(host_buffer_verify1, buffer_size);
 
     for (auto device_id : device_ids) {
       SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
@@ -108,7 +114,11 @@ void ZeBandwidth::transfer_size_test(
     }
   }
 
+  // The first copy includes the registration of host memory the driver
+  // does not know yet, at append or at execution.
+  Timer<std::chrono::nanoseconds::period> first_copy_timer;
   if (use_immediate_command_list == false) {
+    first_copy_timer.start();
     for (auto device_id : device_ids) {
       SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
           command_list[device_id], destination_buffer[device_id],
@@ -132,6 +142,10 @@ void ZeBandwidth::transfer_size_test(
         benchmark->commandQueueSynchronize(command_queue[device_id]);
       }
 
+      if (i == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
 
@@ -160,11 +174,24 @@ void ZeBandwidth::transfer_size_test(
             timers[device_id].period_minus_overhead();
       }
 
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
+
+      if (verify) {
+        verify_timer.start();
+        number_of_errors += verify_transfer(destination_buffer, buffer_size,
+                                            expected_checksum);
+        verify_timer.end();
+        verify_time_nsec += verify_timer.period_minus_overhead();
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
     timer.end();
 
-    total_time_nsec = timer.period_minus_overhead();
+    total_time_nsec = timer.period_minus_overhead() - verify_time_nsec;
 
     for (auto device_id : device_ids) {
       benchmark->commandListReset(command_list[device_id]);
@@ -172,6 +199,9 @@ void ZeBandwidth::transfer_size_test(
   } else {
     // warm-up
     for (uint32_t i = 0; i < warmup_iterations; i++) {
+      if (i == 0) {
+        first_copy_timer.start();
+      }
       for (auto device_id : device_ids) {
         SUCCESS_OR_TERMINATE(zeEventHostReset(event[device_id]));
         SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
@@ -187,6 +217,10 @@ void ZeBandwidth::transfer_size_test(
             zeEventHostSynchronize(event[device_id], UINT64_MAX));
       }
 
+      if (i == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
 
@@ -196,6 +230,9 @@ void ZeBandwidth::transfer_size_test(
 
     timer.start();
     for (uint32_t i = 0; i < number_iterations; i++) {
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.start();
+      }
       for (auto device_id : device_ids) {
         SUCCESS_OR_TERMINATE(zeEventHostReset(event[device_id]));
         SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
@@ -219,38 +256,28 @@ void ZeBandwidth::transfer_size_test(
             timers[device_id].period_minus_overhead();
       }
 
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
+
+      if (verify) {
+        verify_timer.start();
+        number_of_errors += verify_transfer(destination_buffer, buffer_size,
+                                            expected_checksum);
+        verify_timer.end();
+        verify_time_nsec += verify_timer.period_minus_overhead();
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
     timer.end();
 
-    total_time_nsec = timer.period_minus_overhead();
+    total_time_nsec = timer.period_minus_overhead() - verify_time_nsec;
   }
 
   if (verify) {
-    uint32_t number_of_errors = 0;
-    benchmark->memoryAllocHost(buffer_size, &host_buffer_verify);
-
-    for (auto device_id : device_ids) {
-      SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
-          command_list_verify, host_buffer_verify,
-          destination_buffer[device_id], buffer_size, nullptr, 0, nullptr));
-      benchmark->commandListClose(command_list_verify);
-      benchmark->commandQueueExecuteCommandList(command_queue_verify, 1,
-                                                &command_list_verify);
-      benchmark->commandQueueSynchronize(command_queue_verify);
-      benchmark->commandListReset(command_list_verify);
-
-      char *host_buffer_verify_char = static_cast<char *>(host_buffer_verify);
-      char *host_buffer_verify_char1 = static_cast<char *>(host_buffer_verify1);
-      for (uint32_t i = 0; i < buffer_size; i++) {
-        if (host_buffer_verify_char[i] != host_buffer_verify_char1[i]) {
-          number_of_errors++;
-        }
-      }
-    }
-
     benchmark->memoryFree(host_buffer_verify1);
-    benchmark->memoryFree(host_buffer_verify);
 
     if (number_of_errors > 0) {
       throw std::runtime_error("Host memory verification failed ");
@@ -260,6 +287,25 @@ void ZeBandwidth::transfer_size_test(
   }
 }
 
+//---------------------------------------------------------------------
+// Number of destination buffers whose checksum, computed on the device
+// holding the buffer, differs from the checksum of the source data. Only
+// the partial sums of the checksum kernel are read back, so the result of
+// every timed iteration can be checked.
+//---------------------------------------------------------------------
+uint32_t ZeBandwidth::verify_transfer(std::vector<void *> &destination_buffer,
+                                      size_t buffer_size,
+                                      uint64_t expected_checksum) {
+  uint32_t number_of_errors = 0;
+  for (auto device_id : device_ids) {
+    if (checksum->compute(destination_buffer[device_id], buffer_size) !=
+        expected_checksum) {
+      number_of_errors++;
+    }
+  }
+  return number_of_errors;
+}
+
 void ZeBandwidth::transfer_bidir_size_test(
     size_t size, std::vector<void *> &destination_buffer,
     std::vector<void *> &source_buffer,
@@ -271,7 +317,9 @@ void ZeBandwidth::transfer_bidir_size_test(
   long double total_time_s;
   long double total_data_transfer;
 
+  Timer<std::chrono::nanoseconds::period> first_copy_timer;
   if (use_immediate_command_list == false) {
+    first_copy_timer.start();
     for (auto device_id : device_ids) {
       SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
           command_list[device_id], destination_buffer[device_id],
@@ -308,6 +356,10 @@ void ZeBandwidth::transfer_bidir_size_test(
         benchmark->commandQueueSynchronize(command_queue1[device_id]);
       }
 
+      if (i == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
 
@@ -339,6 +391,11 @@ void ZeBandwidth::transfer_bidir_size_test(
             timers[device_id].period_minus_overhead();
       }
 
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
     timer.end();
@@ -352,6 +409,9 @@ void ZeBandwidth::transfer_bidir_size_test(
   } else {
     // warm-up
     for (uint32_t i = 0; i < warmup_iterations; i++) {
+      if (i == 0) {
+        first_copy_timer.start();
+      }
       for (auto device_id : device_ids) {
         SUCCESS_OR_TERMINATE(zeEventHostReset(event[device_id]));
         SUCCESS_OR_TERMINATE(zeEventHostReset(event1[device_id]));
@@ -374,6 +434,10 @@ void ZeBandwidth::transfer_bidir_size_test(
             zeEventHostSynchronize(event1[device_id], UINT64_MAX));
       }
 
+      if (i == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
 
@@ -383,6 +447,9 @@ void ZeBandwidth::transfer_bidir_size_test(
 
     timer.start();
     for (uint32_t i = 0; i < number_iterations; i++) {
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.start();
+      }
       for (auto device_id : device_ids) {
         SUCCESS_OR_TERMINATE(zeEventHostReset(event[device_id]));
         SUCCESS_OR_TERMINATE(zeEventHostReset(event1[device_id]));
@@ -413,6 +480,11 @@ void ZeBandwidth::transfer_bidir_size_test(
             timers[device_id].period_minus_overhead();
       }
 
+      if (i == 0 && warmup_iterations == 0) {
+        first_copy_timer.end();
+        first_copy_nsec = first_copy_timer.period_minus_overhead();
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(wait_event));
     }
     timer.end();
@@ -426,9 +498,18 @@ void ZeBandwidth::test_host2device(void) {
   long double total_latency = 0.0;
 
   std::cout << std::endl;
-  std::cout << "HOST-TO-DEVICE BANDWIDTH AND LATENCY" << std::endl;
+  std::cout << "HOST-TO-DEVICE BANDWIDTH AND LATENCY";
+  if (report_host_memory) {
+    std::cout << " (HOST MEMORY " << host_memory << ")";
+  }
+  std::cout << std::endl;
   if (csv_output) {
     std::cout << "Transfer_size,Bandwidth_(GBPS),Latency_(usec)" << std::endl;
+    if (report_host_memory) {
+      std::cout << "Host_memory,Alloc_(usec),First_touch_(usec),"
+                   "First_copy_(usec)"
+                << std::endl;
+    }
   }
 
   for (auto size : transfer_size) {
@@ -437,10 +518,11 @@ void ZeBandwidth::test_host2device(void) {
     for (size_t i = 0U; i < device_times_nsec.size(); i++) {
       device_times_nsec[i] = 0;
     }
+    reset_host_memory_cost();
 
     for (auto device_id : device_ids) {
       benchmark->memoryAlloc(device_id, size, &device_buffers[device_id]);
-      benchmark->memoryAllocHost(size, &host_buffers[device_id]);
+      host_memory_alloc(size, &host_buffers[device_id]);
     }
 
     transfer_size_test(size, device_buffers, host_buffers, device_times_nsec,
@@ -451,7 +533,7 @@ void ZeBandwidth::test_host2device(void) {
     std::cout << "Host->Device\n";
     for (auto device_id : device_ids) {
       benchmark->memoryFree(device_buffers[device_id]);
-      benchmark->memoryFree(host_buffers[device_id]);
+      host_memory_free(host_buffers[device_id]);
 
       calculate_metrics(device_times_nsec[device_id],
                         static_cast<long double>(size * number_iterations),
@@ -466,6 +548,9 @@ void ZeBandwidth::test_host2device(void) {
         total_bandwidth, total_latency);
     print_results(size * device_ids.size(), total_bandwidth, total_latency,
                   "[Total    ");
+    if (report_host_memory) {
+      print_host_memory_cost();
+    }
     std::cout << "-----------------------------------------------------"
                  "---------------------------\n";
   }
@@ -476,9 +561,18 @@ void ZeBandwidth::test_device2host(void) {
   long double total_latency = 0.0;
 
   std::cout << std::endl;
-  std::cout << "DEVICE-TO-HOST BANDWIDTH AND LATENCY" << std::endl;
+  std::cout << "DEVICE-TO-HOST BANDWIDTH AND LATENCY";
+  if (report_host_memory) {
+    std::cout << " (HOST MEMORY " << host_memory << ")";
+  }
+  std::cout << std::endl;
   if (csv_output) {
     std::cout << "Transfer_size,Bandwidth_(GBPS),Latency_(usec)" << std::endl;
+    if (report_host_memory) {
+      std::cout << "Host_memory,Alloc_(usec),First_touch_(usec),"
+                   "First_copy_(usec)"
+                << std::endl;
+    }
   }
 
   for (auto size : transfer_size) {
@@ -487,10 +581,11 @@ void ZeBandwidth::test_device2host(void) {
     for (size_t i = 0U; i < device_times_nsec.size(); i++) {
       device_times_nsec[i] = 0;
     }
+    reset_host_memory_cost();
 
     for (auto device_id : device_ids) {
       benchmark->memoryAlloc(device_id, size, &device_buffers[device_id]);
-      benchmark->memoryAllocHost(size, &host_buffers[device_id]);
+      host_memory_alloc(size, &host_buffers[device_id]);
     }
 
     transfer_size_test(size, host_buffers, device_buffers, device_times_nsec,
@@ -501,7 +596,7 @@ void ZeBandwidth::test_device2host(void) {
     std::cout << "Device->Host\n";
     for (auto device_id : device_ids) {
       benchmark->memoryFree(device_buffers[device_id]);
-      benchmark->memoryFree(host_buffers[device_id]);
+      host_memory_free(host_buffers[device_id]);
 
       calculate_metrics(device_times_nsec[device_id],
                         static_cast<long double>(size * number_iterations),
@@ -516,6 +611,9 @@ void ZeBandwidth::test_device2host(void) {
         total_bandwidth, total_latency);
     print_results(size * device_ids.size(), total_bandwidth, total_latency,
                   "[Total    ");
+    if (report_host_memory) {
+      print_host_memory_cost();
+    }
     std::cout << "-----------------------------------------------------"
                  "---------------------------\n";
   }
@@ -527,10 +625,18 @@ void ZeBandwidth::test_bidir(void) {
 
   std::cout << std::endl;
   std::cout
-      << "BIDIRECTIONAL HOST-TO-DEVICE/DEVICE-TO-HOST BANDWIDTH AND LATENCY"
-      << std::endl;
+      << "BIDIRECTIONAL HOST-TO-DEVICE/DEVICE-TO-HOST BANDWIDTH AND LATENCY";
+  if (report_host_memory) {
+    std::cout << " (HOST MEMORY " << host_memory << ")";
+  }
+  std::cout << std::endl;
   if (csv_output) {
     std::cout << "Transfer_size,Bandwidth_(GBPS),Latency_(usec)" << std::endl;
+    if (report_host_memory) {
+      std::cout << "Host_memory,Alloc_(usec),First_touch_(usec),"
+                   "First_copy_(usec)"
+                << std::endl;
+    }
   }
 
   for (auto size : transfer_size) {
@@ -539,12 +645,13 @@ void ZeBandwidth::test_bidir(void) {
     for (size_t i = 0U; i < device_times_nsec.size(); i++) {
       device_times_nsec[i] = 0;
     }
+    reset_host_memory_cost();
 
     for (auto device_id : device_ids) {
       benchmark->memoryAlloc(size, &device_buffers[device_id]);
-      benchmark->memoryAllocHost(size, &host_buffers[device_id]);
+      host_memory_alloc(size, &host_buffers[device_id]);
       benchmark->memoryAlloc(size, &device_buffers_bidir[device_id]);
-      benchmark->memoryAllocHost(size, &host_buffers_bidir[device_id]);
+      host_memory_alloc(size, &host_buffers_bidir[device_id]);
     }
 
     transfer_bidir_size_test(size, device_buffers, host_buffers,
@@ -556,9 +663,9 @@ void ZeBandwidth::test_bidir(void) {
     std::cout << "Host<->Device\n";
     for (auto device_id : device_ids) {
       benchmark->memoryFree(device_buffers[device_id]);
-      benchmark->memoryFree(host_buffers[device_id]);
+      host_memory_free(host_buffers[device_id]);
       benchmark->memoryFree(device_buffers_bidir[device_id]);
-      benchmark->memoryFree(host_buffers_bidir[device_id]);
+      host_memory_free(host_buffers_bidir[device_id]);
 
       calculate_metrics(device_times_nsec[device_id],
                         static_cast<long double>(2 * size * number_iterations),
@@ -573,6 +680,9 @@ void ZeBandwidth::test_bidir(void) {
                       total_bandwidth, total_latency);
     print_results(size * device_ids.size(), total_bandwidth, total_latency,
                   "[Total    ");
+    if (report_host_memory) {
+      print_host_memory_cost();
+    }
     std::cout << "-----------------------------------------------------"
                  "---------------------------\n";
   }
@@ -701,6 +811,7 @@ void ZeBandwidth::ze_bandwidth_query_engines() {
   if (verify) {
     benchmark->commandQueueCreate(0, 0, 0, &command_queue_verify);
     benchmark->commandListCreate(0, 0, &command_list_verify);
+    checksum = new ZeChecksum(benchmark);
   }
 
   ze_event_pool_desc_t event_pool_desc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
@@ -752,6 +863,10 @@ int main(int argc, char **argv) {
   bw.ze_bandwidth_query_engines();
 
   if (!bw.query_engines) {
+    if (!bw.env_guard.setup(bw.benchmark->_devices[bw.device_ids[0]])) {
+      return 1;
+    }
+
     default_size = bw.transfer_lower_limit;
     while (default_size < bw.transfer_upper_limit) {
       bw.transfer_size.push_back(default_size);
@@ -769,20 +884,29 @@ int main(int argc, char **argv) {
     bw.host_buffers_bidir.resize(bw.benchmark->_devices.size());
 
     if (bw.verify) {
-      bw.number_iterations = 1;
       bw.warmup_iterations = 0;
     }
 
-    if (bw.run_host2dev) {
-      bw.test_host2device();
-    }
+    for (auto &host_memory : bw.host_memory_kinds) {
+      bw.host_memory = host_memory;
+      if (!bw.host_memory_supported()) {
+        std::cout << std::endl
+                  << "HOST MEMORY " << host_memory << ": not supported"
+                  << std::endl;
+        continue;
+      }
 
-    if (bw.run_dev2host) {
-      bw.test_device2host();
-    }
+      if (bw.run_host2dev) {
+        bw.test_host2device();
+      }
+
+      if (bw.run_dev2host) {
+        bw.test_device2host();
+      }
 
-    if (bw.run_bidirectional) {
-      bw.test_bidir();
+      if (bw.run_bidirectional) {
+        bw.test_bidir();
+      }
     }
 
     std::cout << std::endl;
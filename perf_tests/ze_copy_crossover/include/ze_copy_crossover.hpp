@@ -0,0 +1,98 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_COPY_CROSSOVER_HPP
+#define ZE_COPY_CROSSOVER_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum memory_type_t { MEMORY_DEVICE = 0, MEMORY_HOST = 1, MEMORY_SHARED = 2 };
+
+enum copy_method_t {
+  COPY_ENGINE = 0,    /* zeCommandListAppendMemoryCopy on a copy-only group */
+  COMPUTE_ENGINE = 1, /* zeCommandListAppendMemoryCopy on a compute group */
+  COPY_KERNEL = 2,    /* vectorized copy kernel on a compute group */
+  COPY_METHOD_COUNT = 3
+};
+
+struct copy_result_t {
+  bool measured = false;
+  long double gbps = 0;
+  long double latency_usec = 0;
+  bool valid = true;
+};
+
+class ZeCopyCrossover {
+public:
+  ZeCopyCrossover();
+  ~ZeCopyCrossover();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<size_t> transfer_sizes;
+  size_t min_size = 64;
+  size_t max_size = (1 << 28);
+  uint32_t number_iterations = 50;
+  uint32_t warmup_iterations = 5;
+  bool verify = false;
+  std::vector<memory_type_t> source_types;
+  std::vector<memory_type_t> destination_types;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+
+private:
+  void *allocate(memory_type_t type, size_t size);
+  void execute(ze_command_queue_handle_t queue, ze_command_list_handle_t list);
+  void append_kernel_launches(ze_command_list_handle_t list,
+                              ze_kernel_handle_t kernel, void *dst,
+                              const void *src, size_t count,
+                              size_t element_size);
+  void record_copy(copy_method_t method, void *dst, const void *src,
+                   size_t size);
+  bool check_copy(void *dst, size_t size);
+  copy_result_t measure(copy_method_t method, void *dst, void *src,
+                        size_t size);
+  copy_method_t winner(const copy_result_t *results);
+  void report_pair(memory_type_t src_type, memory_type_t dst_type,
+                   const std::vector<std::vector<copy_result_t>> &results,
+                   ptree &measurements, ptree &decision_table);
+
+  ZeApp *benchmark;
+  bool copy_engine_available = false;
+  uint32_t compute_ordinal = 0;
+  uint32_t copy_ordinal = 0;
+  uint32_t group_size = 256;
+  ze_kernel_handle_t copy_uint4_kernel = nullptr;
+  ze_kernel_handle_t copy_uchar_kernel = nullptr;
+  ze_command_queue_handle_t compute_queue = nullptr;
+  ze_command_list_handle_t compute_list = nullptr;
+  ze_command_queue_handle_t copy_queue = nullptr;
+  ze_command_list_handle_t copy_list = nullptr;
+  ze_command_list_handle_t helper_list = nullptr;
+  uint8_t *host_staging = nullptr;
+  uint8_t *reference = nullptr;
+};
+
+#endif /* ZE_COPY_CROSSOVER_HPP */
@@ -0,0 +1,17 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+kernel void copy_uint4(global uint4 *dst, const global uint4 *src) {
+  const size_t i = get_global_id(0);
+  dst[i] = src[i];
+}
+
+kernel void copy_uchar(global uchar *dst, const global uchar *src) {
+  const size_t i = get_global_id(0);
+  dst[i] = src[i];
+}
@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_copy_crossover.hpp"
+
+static bool to_memory_types(const std::string &name,
+                            std::vector<memory_type_t> &types) {
+  types.clear();
+  if (name == "all" || name == "device") {
+    types.push_back(MEMORY_DEVICE);
+  }
+  if (name == "all" || name == "host") {
+    types.push_back(MEMORY_HOST);
+  }
+  if (name == "all" || name == "shared") {
+    types.push_back(MEMORY_SHARED);
+  }
+  return !types.empty();
+}
+
+int ZeCopyCrossover::parse_command_line(int argc, char **argv) {
+
+  std::string source = "all";
+  std::string destination = "all";
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "min-size", po::value<size_t>(&min_size)->default_value(64),
+        "set smallest transfer size in bytes")(
+        "max-size", po::value<size_t>(&max_size)->default_value(1 << 28),
+        "set largest transfer size in bytes, sizes grow by a factor of 4")(
+        "warmup", po::value<uint32_t>(&warmup_iterations)->default_value(5),
+        "set number of warmup operations")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(50),
+        "set number of iterations")(
+        "src", po::value<std::string>(&source)->default_value("all"),
+        "source memory type like device/host/shared/all")(
+        "dst", po::value<std::string>(&destination)->default_value("all"),
+        "destination memory type like device/host/shared/all")(
+        "verify", po::bool_switch(&verify),
+        "validate the copied data of every measurement")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  } else if (!to_memory_types(source, source_types)) {
+    std::cout << "unknown source memory type" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (!to_memory_types(destination, destination_types)) {
+    std::cout << "unknown destination memory type" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (min_size == 0 || min_size > max_size) {
+    std::cout << "invalid transfer size range" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (number_iterations == 0) {
+    std::cout << "number of iterations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  transfer_sizes.clear();
+  for (size_t size = min_size; size < max_size; size *= 4) {
+    transfer_sizes.push_back(size);
+  }
+  transfer_sizes.push_back(max_size);
+
+  return 0;
+}
@@ -0,0 +1,383 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_copy_crossover.hpp"
+
+#include <algorithm>
+
+static const char *memory_type_names[] = {"device", "host", "shared"};
+// Indexed by copy_method_t, COPY_METHOD_COUNT when no method is valid
+static const char *copy_method_names[] = {"copy_engine", "compute_engine",
+                                          "kernel", "none"};
+static const char *copy_method_short_names[] = {"CE", "CCS", "KRN", "none"};
+
+ZeCopyCrossover::ZeCopyCrossover() {
+  benchmark = new ZeApp("ze_copy_crossover.spv");
+  benchmark->singleDeviceInit();
+
+  if (!benchmark->queueGroupOrdinal(0, false, &compute_ordinal)) {
+    std::cerr << "No compute queue group found" << std::endl;
+    std::terminate();
+  }
+  copy_engine_available = benchmark->queueGroupOrdinal(0, true, &copy_ordinal);
+
+  benchmark->commandQueueCreate(0, compute_ordinal, &compute_queue);
+  benchmark->commandListCreate(0, compute_ordinal, &compute_list);
+  benchmark->commandListCreate(0, compute_ordinal, &helper_list);
+  if (copy_engine_available) {
+    benchmark->commandQueueCreate(0, copy_ordinal, &copy_queue);
+    benchmark->commandListCreate(0, copy_ordinal, &copy_list);
+  }
+
+  benchmark->functionCreate(&copy_uint4_kernel, "copy_uint4");
+  benchmark->functionCreate(&copy_uchar_kernel, "copy_uchar");
+
+  ze_device_compute_properties_t compute_properties = {};
+  compute_properties.stype = ZE_STRUCTURE_TYPE_DEVICE_COMPUTE_PROPERTIES;
+  SUCCESS_OR_TERMINATE(zeDeviceGetComputeProperties(benchmark->_devices[0],
+                                                    &compute_properties));
+  group_size = std::min(group_size, compute_properties.maxGroupSizeX);
+}
+
+ZeCopyCrossover::~ZeCopyCrossover() {
+  benchmark->functionDestroy(copy_uint4_kernel);
+  benchmark->functionDestroy(copy_uchar_kernel);
+  if (copy_engine_available) {
+    benchmark->commandListDestroy(copy_list);
+    benchmark->commandQueueDestroy(copy_queue);
+  }
+  benchmark->commandListDestroy(helper_list);
+  benchmark->commandListDestroy(compute_list);
+  benchmark->commandQueueDestroy(compute_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeCopyCrossover::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeCopyCrossover::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+void *ZeCopyCrossover::allocate(memory_type_t type, size_t size) {
+  void *ptr = nullptr;
+  switch (type) {
+  case MEMORY_DEVICE:
+    benchmark->memoryAlloc(0, size, &ptr);
+    break;
+  case MEMORY_HOST:
+    benchmark->memoryAllocHost(size, &ptr);
+    break;
+  case MEMORY_SHARED:
+    benchmark->memoryAllocShared(0, size, &ptr);
+    break;
+  }
+  return ptr;
+}
+
+void ZeCopyCrossover::execute(ze_command_queue_handle_t queue,
+                              ze_command_list_handle_t list) {
+  SUCCESS_OR_TERMINATE(
+      zeCommandQueueExecuteCommandLists(queue, 1, &list, nullptr));
+  SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(queue, UINT64_MAX));
+}
+
+// Launches one work-item per element. Full work-groups are covered by one
+// launch, the remaining elements by a second launch with a smaller group.
+void ZeCopyCrossover::append_kernel_launches(ze_command_list_handle_t list,
+                                             ze_kernel_handle_t kernel,
+                                             void *dst, const void *src,
+                                             size_t count,
+                                             size_t element_size) {
+  size_t full_groups = count / group_size;
+  uint32_t remainder = static_cast<uint32_t>(count % group_size);
+
+  if (full_groups > 0) {
+    ze_group_count_t group_count = {static_cast<uint32_t>(full_groups), 1, 1};
+    SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, group_size, 1, 1));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(dst), &dst));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 1, sizeof(src), &src));
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        list, kernel, &group_count, nullptr, 0, nullptr));
+  }
+
+  if (remainder > 0) {
+    size_t offset = full_groups * group_size * element_size;
+    void *dst_tail = static_cast<uint8_t *>(dst) + offset;
+    const void *src_tail = static_cast<const uint8_t *>(src) + offset;
+    ze_group_count_t group_count = {1, 1, 1};
+    SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, remainder, 1, 1));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(dst_tail), &dst_tail));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 1, sizeof(src_tail), &src_tail));
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        list, kernel, &group_count, nullptr, 0, nullptr));
+  }
+}
+
+void ZeCopyCrossover::record_copy(copy_method_t method, void *dst,
+                                  const void *src, size_t size) {
+  ze_command_list_handle_t list =
+      (method == COPY_ENGINE) ? copy_list : compute_list;
+
+  benchmark->commandListReset(list);
+  if (method == COPY_KERNEL) {
+    // 16-byte vectors for the bulk of the buffer, bytes for the tail.
+    size_t vectors = size / 16;
+    append_kernel_launches(list, copy_uint4_kernel, dst, src, vectors, 16);
+    append_kernel_launches(list, copy_uchar_kernel,
+                           static_cast<uint8_t *>(dst) + vectors * 16,
+                           static_cast<const uint8_t *>(src) + vectors * 16,
+                           size % 16, 1);
+  } else {
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(list, dst, src, size,
+                                                       nullptr, 0, nullptr));
+  }
+  benchmark->commandListClose(list);
+}
+
+bool ZeCopyCrossover::check_copy(void *dst, size_t size) {
+  benchmark->commandListReset(helper_list);
+  SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+      helper_list, host_staging, dst, size, nullptr, 0, nullptr));
+  benchmark->commandListClose(helper_list);
+  execute(compute_queue, helper_list);
+
+  return memcmp(host_staging, reference, size) == 0;
+}
+
+copy_result_t ZeCopyCrossover::measure(copy_method_t method, void *dst,
+                                       void *src, size_t size) {
+  Timer<std::chrono::microseconds::period> timer;
+  copy_result_t result;
+  ze_command_queue_handle_t queue =
+      (method == COPY_ENGINE) ? copy_queue : compute_queue;
+  ze_command_list_handle_t list =
+      (method == COPY_ENGINE) ? copy_list : compute_list;
+
+  if (verify) {
+    const uint8_t zero = 0;
+    benchmark->commandListReset(helper_list);
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryFill(
+        helper_list, dst, &zero, sizeof(zero), size, nullptr, 0, nullptr));
+    benchmark->commandListClose(helper_list);
+    execute(compute_queue, helper_list);
+  }
+
+  record_copy(method, dst, src, size);
+
+  for (uint32_t i = 0U; i < warmup_iterations; i++) {
+    execute(queue, list);
+  }
+
+  timer.start();
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    execute(queue, list);
+  }
+  timer.end();
+
+  result.measured = true;
+  result.latency_usec = timer.period_minus_overhead() / number_iterations;
+  result.gbps =
+      static_cast<long double>(size) / ONE_GB / (result.latency_usec / 1e6);
+  if (verify) {
+    result.valid = check_copy(dst, size);
+  }
+  return result;
+}
+
+// Fastest of the methods measured with a valid copy, COPY_METHOD_COUNT if
+// there is none.
+copy_method_t ZeCopyCrossover::winner(const copy_result_t *results) {
+  copy_method_t best = COPY_METHOD_COUNT;
+  for (size_t m = 0; m < COPY_METHOD_COUNT; m++) {
+    if (results[m].measured && results[m].valid &&
+        (best == COPY_METHOD_COUNT || results[m].gbps > results[best].gbps)) {
+      best = static_cast<copy_method_t>(m);
+    }
+  }
+  return best;
+}
+
+// Prints one row per transfer size and adds the measurements and the ranges
+// of sizes won by each method to the JSON output. The first range starts at
+// size 0 and every range ends where the next one starts, so the table
+// covers every size up to the largest one measured.
+void ZeCopyCrossover::report_pair(
+    memory_type_t src_type, memory_type_t dst_type,
+    const std::vector<std::vector<copy_result_t>> &results,
+    ptree &measurements, ptree &decision_table) {
+  ptree ranges;
+  ptree range;
+  copy_method_t current = COPY_METHOD_COUNT;
+  bool range_open = false;
+
+  std::cout << "Source: " << memory_type_names[src_type]
+            << "  Destination: " << memory_type_names[dst_type] << std::endl;
+
+  for (size_t s = 0; s < transfer_sizes.size(); s++) {
+    const copy_result_t *result = results[s].data();
+    copy_method_t best = winner(result);
+
+    std::cout << "\t[" << std::setw(10) << transfer_sizes[s] << "]:";
+    for (size_t m = 0; m < COPY_METHOD_COUNT; m++) {
+      std::cout << "  " << std::setw(3) << copy_method_short_names[m] << " = ";
+      if (result[m].measured) {
+        std::cout << std::fixed << std::setw(9) << std::setprecision(3)
+                  << result[m].gbps << " GBPS";
+        if (!result[m].valid) {
+          std::cout << " (FAILED)";
+        }
+      } else {
+        std::cout << std::setw(9) << "n/a"
+                  << "     ";
+      }
+    }
+    std::cout << "  winner = " << copy_method_short_names[best] << std::endl;
+
+    if (!is_json_output_enabled()) {
+      continue;
+    }
+    try {
+      ptree measurement;
+      measurement.put("Source", memory_type_names[src_type]);
+      measurement.put("Destination", memory_type_names[dst_type]);
+      measurement.put("Size", transfer_sizes[s]);
+      for (size_t m = 0; m < COPY_METHOD_COUNT; m++) {
+        if (result[m].measured) {
+          std::string name = copy_method_names[m];
+          measurement.put(name + " GBPS", result[m].gbps);
+          measurement.put(name + " Latency(usec)", result[m].latency_usec);
+          if (verify) {
+            measurement.put(name + " Result",
+                            result[m].valid ? "PASSED" : "FAILED");
+          }
+        }
+      }
+      measurement.put("Winner", copy_method_names[best]);
+      measurements.push_back(std::make_pair("", measurement));
+
+      if (!range_open || best != current) {
+        if (range_open) {
+          range.put("Max size", transfer_sizes[s] - 1);
+          ranges.push_back(std::make_pair("", range));
+        }
+        range = ptree();
+        range.put("Min size", s == 0 ? 0 : transfer_sizes[s]);
+        range.put("Method", copy_method_names[best]);
+        current = best;
+        range_open = true;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting copy crossover measurement: " << e.what()
+                << std::endl;
+    }
+  }
+
+  if (is_json_output_enabled()) {
+    try {
+      range.put("Max size", transfer_sizes.back());
+      ranges.push_back(std::make_pair("", range));
+
+      ptree entry;
+      entry.put("Source", memory_type_names[src_type]);
+      entry.put("Destination", memory_type_names[dst_type]);
+      entry.put_child("Ranges", ranges);
+      decision_table.push_back(std::make_pair("", entry));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting copy crossover decision table: "
+                << e.what() << std::endl;
+    }
+  }
+
+  std::cout << "-----------------------------------------------------"
+               "---------------------------\n";
+}
+
+void ZeCopyCrossover::run(void) {
+  ptree measurements;
+  ptree decision_table;
+
+  if (!copy_engine_available) {
+    std::cout << "No copy-only queue group found, copy engine results are "
+                 "not available"
+              << std::endl;
+  }
+
+  benchmark->memoryAllocHost(max_size, reinterpret_cast<void **>(&reference));
+  benchmark->memoryAllocHost(max_size,
+                             reinterpret_cast<void **>(&host_staging));
+  for (size_t i = 0; i < max_size; i++) {
+    reference[i] = static_cast<uint8_t>(i % 251);
+  }
+
+  for (memory_type_t src_type : source_types) {
+    for (memory_type_t dst_type : destination_types) {
+      void *src = allocate(src_type, max_size);
+      void *dst = allocate(dst_type, max_size);
+
+      benchmark->commandListReset(helper_list);
+      SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+          helper_list, src, reference, max_size, nullptr, 0, nullptr));
+      benchmark->commandListClose(helper_list);
+      execute(compute_queue, helper_list);
+
+      std::vector<std::vector<copy_result_t>> results(
+          transfer_sizes.size(), std::vector<copy_result_t>(COPY_METHOD_COUNT));
+      for (size_t s = 0; s < transfer_sizes.size(); s++) {
+        for (size_t m = 0; m < COPY_METHOD_COUNT; m++) {
+          copy_method_t method = static_cast<copy_method_t>(m);
+          if (method == COPY_ENGINE && !copy_engine_available) {
+            continue;
+          }
+          results[s][m] = measure(method, dst, src, transfer_sizes[s]);
+        }
+      }
+
+      report_pair(src_type, dst_type, results, measurements, decision_table);
+
+      benchmark->memoryFree(src);
+      benchmark->memoryFree(dst);
+    }
+  }
+
+  benchmark->memoryFree(reference);
+  benchmark->memoryFree(host_staging);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.copy_crossover",
+                           measurements);
+      env_guard.add_to(ptree_main);
+      ptree_main.put_child("Decision table", decision_table);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeCopyCrossover copy_crossover;
+  SUCCESS_OR_TERMINATE(copy_crossover.parse_command_line(argc, argv));
+  if (!copy_crossover.setup_environment()) {
+    return 1;
+  }
+  copy_crossover.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
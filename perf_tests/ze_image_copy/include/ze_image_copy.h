@@ -12,6 +12,9 @@
 #include "common.hpp"
 #include <level_zero/ze_api.h>
 #include "ze_app.hpp"
+#include "ze_checksum.hpp"
+#include "ze_env_guard.hpp"
+#include "ze_sample_stats.hpp"
 #include "utils/utils_string.hpp"
 
 #include <assert.h>
@@ -41,12 +44,14 @@ public:
   bool validRet = false;
   long double gbps;
   long double latency;
+  ZeSampleStats latency_stats; /* latency of each timed iteration */
   ptree param_array;
   ze_image_format_layout_t Imagelayout = ZE_IMAGE_FORMAT_LAYOUT_8;
   ze_image_flags_t Imageflags = 0;
   ze_image_type_t Imagetype = ZE_IMAGE_TYPE_2D;
   ze_image_format_type_t Imageformat = ZE_IMAGE_FORMAT_TYPE_UINT;
   std::string JsonFileName;
+  ZeEnvGuard env_guard{GOVERNOR_IGNORE, 0};
   ZeImageCopy();
   ~ZeImageCopy();
   void measureHost2Device2Host();
@@ -56,12 +61,13 @@ public:
   void measureSerialDevice2Host();
   int parse_command_line(int argc, char **argv);
   bool is_json_output_enabled();
+  bool setup_environment(void);
 
 private:
   void initialize_buffer(void);
   void test_initialize(void);
   void test_cleanup(void);
-  void validate_data_buffer(void);
+  void validate_data_buffer(bool check_destination);
   void reset_all_events(void);
 
   ZeApp *benchmark;
@@ -69,6 +75,7 @@ private:
   ze_command_list_handle_t command_list;
   ze_command_list_handle_t command_list_a;
   ze_command_list_handle_t command_list_b;
+  ze_command_list_handle_t validation_list;
   ze_image_handle_t image;
   ze_event_handle_t *hdevice_event;
   ze_event_pool_handle_t event_pool;
@@ -78,6 +85,8 @@ private:
   ze_image_desc_t imageDesc = {};
   uint8_t *srcBuffer;
   uint8_t *dstBuffer;
+  uint8_t *validation_buffer = nullptr; /* device copy of the image */
+  ZeChecksum *checksum = nullptr;
   size_t buffer_size;
   uint32_t num_wait_events;
 };
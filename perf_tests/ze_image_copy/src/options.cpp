@@ -54,6 +54,7 @@ int ZeImageCopy::parse_command_line(int argc, char **argv) {
         "json-output-file", po::value<std::string>(&JsonFileName),
         "test output format file name to be specified");
 
+    desc.add(env_guard.options());
     po::store(po::parse_command_line(argc, argv, desc), vm);
     po::notify(vm);
   } catch (const std::exception &e) {
@@ -23,6 +23,7 @@ ZeImageCopy ::ZeImageCopy() {
   benchmark->commandListCreate(&this->command_list);
   benchmark->commandListCreate(&this->command_list_a);
   benchmark->commandListCreate(&this->command_list_b);
+  benchmark->commandListCreate(&this->validation_list);
 }
 
 ZeImageCopy ::~ZeImageCopy() {
@@ -30,6 +31,8 @@ ZeImageCopy ::~ZeImageCopy() {
   benchmark->commandListDestroy(this->command_list);
   benchmark->commandListDestroy(this->command_list_a);
   benchmark->commandListDestroy(this->command_list_b);
+  benchmark->commandListDestroy(this->validation_list);
+  delete checksum;
   benchmark->singleDeviceCleanup();
 
   delete benchmark;
@@ -39,6 +42,10 @@ bool ZeImageCopy::is_json_output_enabled(void) {
   return JsonFileName.size() != 0;
 }
 
+bool ZeImageCopy::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
 void ZeImageCopy::test_initialize(void) {
   size_t buffer_size_tmp = level_zero_tests::num_bytes_per_pixel(Imagelayout) *
                            width * height * depth;
@@ -85,6 +92,10 @@ void ZeImageCopy::test_initialize(void) {
   }
 
   benchmark->imageCreate(&imageDesc, &this->image);
+  if (this->data_validation) {
+    benchmark->memoryAlloc(buffer_size,
+                           reinterpret_cast<void **>(&validation_buffer));
+  }
 
   // Besides having events for image copies, one more event is reserved to
   // indicate completion event of entire batch of commands.
@@ -108,6 +119,10 @@ void ZeImageCopy::test_cleanup(void) {
 #endif
   benchmark->imageDestroy(this->image);
   image = nullptr;
+  if (validation_buffer) {
+    benchmark->memoryFree(validation_buffer);
+    validation_buffer = nullptr;
+  }
   for (uint32_t i = 0U; i < num_wait_events; i++)
     benchmark->destroy_event(hdevice_event[i]);
   benchmark->destroy_event_pool(this->event_pool);
@@ -121,10 +136,31 @@ void ZeImageCopy::reset_all_events(void) {
   }
 }
 
-void ZeImageCopy::validate_data_buffer(void) {
-  if (this->data_validation) {
-    validRet =
-        (0 == memcmp(this->srcBuffer, this->dstBuffer, this->buffer_size));
+// Copies the image to a device buffer and checksums it on the device, so
+// only the partial sums of the checksum kernel are read back. Tests whose
+// timed copies write to dstBuffer also compare its checksum, which is
+// computed on the host as dstBuffer is host memory.
+void ZeImageCopy::validate_data_buffer(bool check_destination) {
+  if (!this->data_validation) {
+    return;
+  }
+  if (checksum == nullptr) {
+    checksum = new ZeChecksum(benchmark);
+  }
+  benchmark->commandListReset(validation_list);
+  benchmark->commandListAppendImageCopyToMemory(
+      validation_list, validation_buffer, image, &this->region);
+  benchmark->commandListClose(validation_list);
+  benchmark->commandQueueExecuteCommandList(command_queue, 1,
+                                            &validation_list);
+  benchmark->commandQueueSynchronize(command_queue);
+
+  uint64_t expected_checksum = ZeChecksum::host(srcBuffer, buffer_size);
+  validRet =
+      checksum->compute(validation_buffer, buffer_size) == expected_checksum;
+  if (check_destination) {
+    validRet = validRet &&
+               ZeChecksum::host(dstBuffer, buffer_size) == expected_checksum;
   }
 }
 
@@ -175,7 +211,7 @@ void ZeImageCopy::measureHost2Device2Host() {
   gbps = total_data_transfer / total_time_s;
 
   std::cout << gbps << " GBPS\n";
-  this->validate_data_buffer();
+  this->validate_data_buffer(true);
   this->test_cleanup();
 }
 
@@ -188,8 +224,9 @@ void ZeImageCopy::measureParallelHost2Device() {
 
   ze_result_t result = ZE_RESULT_SUCCESS;
   this->test_initialize();
+  latency_stats = ZeSampleStats();
 
-  // Copy from srcBuffer->Image->dstBuffer, so at the end dstBuffer = srcBuffer
+  // Copy from srcBuffer->Image, validation checks the image on the device
   benchmark->commandListReset(command_list_a);
   for (uint32_t i = 0U; i < num_image_copies; i++) {
     benchmark->commandListAppendImageCopyFromMemory(command_list_a, image,
@@ -197,19 +234,11 @@ void ZeImageCopy::measureParallelHost2Device() {
   }
   benchmark->commandListClose(command_list_a);
 
-  benchmark->commandListReset(command_list_b);
-  benchmark->commandListAppendImageCopyToMemory(command_list_b, dstBuffer,
-                                                image, &this->region);
-  benchmark->commandListClose(command_list_b);
-
   /* Warm up */
 
   benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list_a);
   benchmark->commandQueueSynchronize(command_queue);
 
-  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list_b);
-  benchmark->commandQueueSynchronize(command_queue);
-
   for (uint32_t i = 0U; i < num_iterations; i++) {
 
     // Measure the bandwidth of copy from host to device only
@@ -219,13 +248,11 @@ void ZeImageCopy::measureParallelHost2Device() {
     SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
     timer.end();
 
-    total_time_usec += timer.period_minus_overhead();
+    long double iteration_usec = timer.period_minus_overhead();
+    total_time_usec += iteration_usec;
+    latency_stats.add(iteration_usec / num_image_copies);
   }
 
-  // The below commands for command_list_b for final validation at the end
-  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list_b);
-  benchmark->commandQueueSynchronize(command_queue);
-
   total_time_s = total_time_usec / 1e6;
 
   total_data_transfer = (buffer_size * num_image_copies * num_iterations) /
@@ -237,7 +264,7 @@ void ZeImageCopy::measureParallelHost2Device() {
             static_cast<long double>(num_image_copies * num_iterations);
   std::cout << std::setprecision(11) << latency << " us"
             << " (Latency: Host->Device)" << std::endl;
-  this->validate_data_buffer();
+  this->validate_data_buffer(false);
   this->test_cleanup();
 }
 
@@ -250,6 +277,7 @@ void ZeImageCopy::measureParallelDevice2Host() {
 
   ze_result_t result = ZE_RESULT_SUCCESS;
   this->test_initialize();
+  latency_stats = ZeSampleStats();
 
   // Copy from srcBuffer->Image->dstBuffer, so at the end dstBuffer = srcBuffer
 
@@ -285,7 +313,9 @@ void ZeImageCopy::measureParallelDevice2Host() {
     SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
     timer.end();
 
-    total_time_usec += timer.period_minus_overhead();
+    long double iteration_usec = timer.period_minus_overhead();
+    total_time_usec += iteration_usec;
+    latency_stats.add(iteration_usec / num_image_copies);
   }
   total_time_s = total_time_usec / 1e6;
 
@@ -299,7 +329,7 @@ void ZeImageCopy::measureParallelDevice2Host() {
             static_cast<long double>(num_image_copies * num_iterations);
   std::cout << std::setprecision(11) << latency << " us"
             << " (Latency: Device->Host)" << std::endl;
-  this->validate_data_buffer();
+  this->validate_data_buffer(true);
   this->test_cleanup();
 }
 
@@ -314,7 +344,6 @@ void ZeImageCopy::measureSerialHost2Device() {
 
   this->test_initialize();
   benchmark->commandListReset(command_list_a);
-  benchmark->commandListReset(command_list_b);
 
   // Queue all image copies where it depends on the previously queued event
   // to start executing. When the first event is signaled, the entire batch
@@ -337,12 +366,6 @@ void ZeImageCopy::measureSerialHost2Device() {
   }
   benchmark->commandListClose(command_list_a);
 
-  // Queue commands on a different command list to copy data from device to host
-  // to validate it.
-  benchmark->commandListAppendImageCopyToMemory(command_list_b, dstBuffer,
-                                                image, &this->region);
-  benchmark->commandListClose(command_list_b);
-
   // Warm up
   for (uint32_t i = 0U; i < warm_up_iterations; i++) {
     // Launch all command queued. They will wait to be executed until after
@@ -373,10 +396,6 @@ void ZeImageCopy::measureSerialHost2Device() {
     total_time_usec += timer.period_minus_overhead();
   }
 
-  // Copy data from device to host to validate it
-  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list_b);
-  benchmark->commandQueueSynchronize(command_queue);
-
   total_time_s = total_time_usec / 1e6;
 
   total_data_transfer = (buffer_size * num_iterations) /
@@ -388,7 +407,7 @@ void ZeImageCopy::measureSerialHost2Device() {
   std::cout << std::setprecision(11) << latency << " us"
             << " (Latency: Host->Device)" << std::endl;
 
-  this->validate_data_buffer();
+  this->validate_data_buffer(false);
   this->test_cleanup();
 }
 
@@ -474,7 +493,7 @@ void ZeImageCopy::measureSerialDevice2Host() {
   latency = total_time_usec / static_cast<long double>(num_iterations);
   std::cout << std::setprecision(11) << latency << " us"
             << " (Latency: Device->Host)" << std::endl;
-  this->validate_data_buffer();
+  this->validate_data_buffer(true);
   this->test_cleanup();
 }
 
@@ -633,6 +652,7 @@ void measure_bandwidth(ZeImageCopy &Imagecopy) {
       Imagecopy.param_array.push_back(std::make_pair("", ptree_Device2Host));
       ptree_main.put_child("Performance Benchmark.bandwidth",
                            Imagecopy.param_array);
+      Imagecopy.env_guard.add_to(ptree_main);
       pt::write_json(Imagecopy.JsonFileName.c_str(), ptree_main);
     } catch (const std::exception &e) {
       std::cerr << "Error writing json output: " << e.what() << std::endl;
@@ -673,6 +693,7 @@ void measure_latency_Host2Device(ZeImageCopyLatency &imageCopyLatency,
   if (imageCopyLatency.is_json_output_enabled()) {
     try {
       test_ptree->put("Latency", imageCopyLatency.latency);
+      imageCopyLatency.latency_stats.add_to(*test_ptree, "Latency");
       if (imageCopyLatency.data_validation)
         test_ptree->put("Result",
                         (imageCopyLatency.validRet ? "PASSED" : "FAILED"));
@@ -716,6 +737,7 @@ void measure_latency_Device2Host(ZeImageCopyLatency &imageCopyLatency,
   if (imageCopyLatency.is_json_output_enabled()) {
     try {
       test_ptree->put("Latency", imageCopyLatency.latency);
+      imageCopyLatency.latency_stats.add_to(*test_ptree, "Latency");
       if (imageCopyLatency.data_validation)
         test_ptree->put("Result",
                         (imageCopyLatency.validRet ? "PASSED" : "FAILED"));
@@ -758,6 +780,9 @@ void measure_latency(ZeImageCopyLatency &imageCopyLatency) {
 int main(int argc, char **argv) {
   ZeImageCopy Imagecopy;
   SUCCESS_OR_TERMINATE(Imagecopy.parse_command_line(argc, argv));
+  if (!Imagecopy.setup_environment()) {
+    return 1;
+  }
   measure_bandwidth(Imagecopy);
 
   ZeImageCopyLatency imageCopyLatency;
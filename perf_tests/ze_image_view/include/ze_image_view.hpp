@@ -0,0 +1,87 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_IMAGE_VIEW_HPP
+#define ZE_IMAGE_VIEW_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+struct plane_t {
+  ze_image_format_layout_t layout; /* layout of the view over the plane */
+  uint32_t divisor;                /* plane size is frame size / divisor */
+  uint32_t bytes_per_texel;
+};
+
+struct planar_format_t {
+  std::string name;
+  ze_image_format_layout_t layout;
+  std::vector<plane_t> planes;
+};
+
+struct view_result_t {
+  bool supported = false;
+  long double create_usec = 0;     /* per zeImageViewCreateExt call */
+  long double destroy_usec = 0;    /* per zeImageDestroy call on a view */
+  long double view_frame_usec = 0; /* kernel reading through the views */
+  long double copy_frame_usec = 0; /* plane copies plus kernel */
+};
+
+class ZeImageView {
+public:
+  ZeImageView();
+  ~ZeImageView();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  uint32_t width = 1920;
+  uint32_t height = 1080;
+  uint32_t view_iterations = 1000;
+  uint32_t number_iterations = 20;
+  bool report_rejected = false;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  ze_image_desc_t image_desc(ze_image_format_layout_t layout, uint32_t w,
+                             uint32_t h);
+  bool create_views(const planar_format_t &format, ze_image_handle_t planar,
+                    std::vector<ze_image_handle_t> &views);
+  void append_read(const planar_format_t &format,
+                   const std::vector<ze_image_handle_t> &planes);
+  long double run_frames(void);
+  view_result_t measure(const planar_format_t &format);
+  void report(const planar_format_t &format, const view_result_t &result);
+
+  ZeApp *benchmark;
+  std::vector<planar_format_t> formats;
+  ze_kernel_handle_t yuv_kernel = nullptr;
+  ze_kernel_handle_t rgb_kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+  void *output_buffer = nullptr;
+};
+
+#endif /* ZE_IMAGE_VIEW_HPP */
@@ -0,0 +1,30 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+/* Luma plane at full resolution, interleaved chroma plane at half resolution
+   in both directions, as in NV12 and P010. */
+kernel void read_yuv_planes(read_only image2d_t luma,
+                            read_only image2d_t chroma, global uint *output) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int w = get_global_size(0);
+  const uint4 l = read_imageui(luma, (int2)(x, y));
+  const uint4 c = read_imageui(chroma, (int2)(x / 2, y / 2));
+  output[y * w + x] = l.x + c.x + c.y;
+}
+
+/* Three planes at full resolution, as in RGBP. */
+kernel void read_rgb_planes(read_only image2d_t r, read_only image2d_t g,
+                            read_only image2d_t b, global uint *output) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int w = get_global_size(0);
+  const int2 coord = (int2)(x, y);
+  output[y * w + x] = read_imageui(r, coord).x + read_imageui(g, coord).x +
+                      read_imageui(b, coord).x;
+}
@@ -0,0 +1,59 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_image_view.hpp"
+
+int ZeImageView::parse_command_line(int argc, char **argv) {
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "width", po::value<uint32_t>(&width)->default_value(1920),
+        "set frame width in pixels, must be even")(
+        "height", po::value<uint32_t>(&height)->default_value(1080),
+        "set frame height in pixels, must be even")(
+        "view-iter", po::value<uint32_t>(&view_iterations)->default_value(1000),
+        "set number of view sets created to measure creation latency")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(20),
+        "set number of frames per measurement")(
+        "report-rejected", po::bool_switch(&report_rejected),
+        "print the formats and views the driver rejects")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  if (width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0) {
+    std::cout << "frame width and height must be even and greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (view_iterations == 0 || number_iterations == 0) {
+    std::cout << "number of iterations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
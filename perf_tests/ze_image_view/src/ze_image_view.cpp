@@ -0,0 +1,329 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_image_view.hpp"
+
+ZeImageView::ZeImageView() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_image_view.spv");
+  benchmark->singleDeviceInit();
+
+  formats.push_back({"NV12",
+                     ZE_IMAGE_FORMAT_LAYOUT_NV12,
+                     {{ZE_IMAGE_FORMAT_LAYOUT_8, 1, 1},
+                      {ZE_IMAGE_FORMAT_LAYOUT_8_8, 2, 2}}});
+  formats.push_back({"P010",
+                     ZE_IMAGE_FORMAT_LAYOUT_P010,
+                     {{ZE_IMAGE_FORMAT_LAYOUT_16, 1, 2},
+                      {ZE_IMAGE_FORMAT_LAYOUT_16_16, 2, 4}}});
+  formats.push_back({"RGBP",
+                     ZE_IMAGE_FORMAT_LAYOUT_RGBP,
+                     {{ZE_IMAGE_FORMAT_LAYOUT_8, 1, 1},
+                      {ZE_IMAGE_FORMAT_LAYOUT_8, 1, 1},
+                      {ZE_IMAGE_FORMAT_LAYOUT_8, 1, 1}}});
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+
+  benchmark->functionCreate(&yuv_kernel, "read_yuv_planes");
+  benchmark->functionCreate(&rgb_kernel, "read_rgb_planes");
+}
+
+ZeImageView::~ZeImageView() {
+  benchmark->functionDestroy(yuv_kernel);
+  benchmark->functionDestroy(rgb_kernel);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeImageView::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeImageView::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+ze_image_desc_t ZeImageView::image_desc(ze_image_format_layout_t layout,
+                                        uint32_t w, uint32_t h) {
+  ze_image_format_t format = {layout,
+                              ZE_IMAGE_FORMAT_TYPE_UINT,
+                              ZE_IMAGE_FORMAT_SWIZZLE_R,
+                              ZE_IMAGE_FORMAT_SWIZZLE_G,
+                              ZE_IMAGE_FORMAT_SWIZZLE_B,
+                              ZE_IMAGE_FORMAT_SWIZZLE_A};
+
+  ze_image_desc_t desc = {};
+  desc.stype = ZE_STRUCTURE_TYPE_IMAGE_DESC;
+  desc.pNext = nullptr;
+  desc.flags = 0;
+  desc.type = ZE_IMAGE_TYPE_2D;
+  desc.format = format;
+  desc.width = w;
+  desc.height = h;
+  desc.depth = 1;
+  desc.arraylevels = 0;
+  desc.miplevels = 0;
+  return desc;
+}
+
+// Appends one view per plane. Returns false if the driver rejects a view.
+bool ZeImageView::create_views(const planar_format_t &format,
+                               ze_image_handle_t planar,
+                               std::vector<ze_image_handle_t> &views) {
+  for (uint32_t p = 0U; p < format.planes.size(); p++) {
+    const plane_t &plane = format.planes[p];
+    ze_image_view_planar_ext_desc_t planar_desc = {};
+    planar_desc.stype = ZE_STRUCTURE_TYPE_IMAGE_VIEW_PLANAR_EXT_DESC;
+    planar_desc.pNext = nullptr;
+    planar_desc.planeIndex = p;
+
+    ze_image_desc_t desc = image_desc(plane.layout, width / plane.divisor,
+                                      height / plane.divisor);
+    desc.pNext = &planar_desc;
+
+    ze_image_handle_t view = nullptr;
+    ze_result_t result = zeImageViewCreateExt(
+        benchmark->context, benchmark->_devices[0], &desc, planar, &view);
+    if (result != ZE_RESULT_SUCCESS) {
+      if (report_rejected) {
+        std::cerr << "WARNING : zeImageViewCreateExt(" << format.name
+                  << ", plane " << p << ") : " << result << std::endl;
+      }
+      return false;
+    }
+    views.push_back(view);
+  }
+  return true;
+}
+
+void ZeImageView::append_read(const planar_format_t &format,
+                              const std::vector<ze_image_handle_t> &planes) {
+  ze_kernel_handle_t kernel = format.planes.size() == 3 ? rgb_kernel
+                                                        : yuv_kernel;
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+
+  uint32_t arg = 0;
+  for (ze_image_handle_t plane : planes) {
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, arg++, sizeof(plane), &plane));
+  }
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      kernel, arg, sizeof(output_buffer), &output_buffer));
+
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+      kernel, width, height, 1, &group_size_x, &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetGroupSize(kernel, group_size_x, group_size_y, 1));
+  ze_group_count_t group_count = {width / group_size_x, height / group_size_y,
+                                  1};
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      command_list, kernel, &group_count, nullptr, 0, nullptr));
+  benchmark->commandListAppendBarrier(command_list);
+}
+
+// Runs the recorded frames once to warm up, then returns usec per frame.
+long double ZeImageView::run_frames(void) {
+  Timer<std::chrono::microseconds::period> timer;
+
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+
+  timer.start();
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+  timer.end();
+
+  return timer.period_minus_overhead() / number_iterations;
+}
+
+view_result_t ZeImageView::measure(const planar_format_t &format) {
+  view_result_t result;
+  Timer<std::chrono::microseconds::period> timer;
+  ze_image_handle_t planar = nullptr;
+
+  ze_image_desc_t desc = image_desc(format.layout, width, height);
+  if (zeImageCreate(benchmark->context, benchmark->_devices[0], &desc,
+                    &planar) != ZE_RESULT_SUCCESS) {
+    return result;
+  }
+
+  // Creation latency, as paid by a pipeline that creates views per frame
+  std::vector<ze_image_handle_t> views;
+  timer.start();
+  for (uint32_t i = 0U; i < view_iterations; i++) {
+    if (!create_views(format, planar, views)) {
+      break;
+    }
+  }
+  timer.end();
+  size_t view_count = views.size();
+  if (view_count == view_iterations * format.planes.size()) {
+    result.supported = true;
+    result.create_usec = timer.period_minus_overhead() / view_count;
+  }
+  timer.start();
+  for (ze_image_handle_t view : views) {
+    benchmark->imageDestroy(view);
+  }
+  timer.end();
+  views.clear();
+  if (!result.supported) {
+    benchmark->imageDestroy(planar);
+    return result;
+  }
+  result.destroy_usec = timer.period_minus_overhead() / view_count;
+
+  size_t frame_size = 0;
+  for (const plane_t &plane : format.planes) {
+    frame_size += static_cast<size_t>(width / plane.divisor) *
+                  (height / plane.divisor) * plane.bytes_per_texel;
+  }
+  std::vector<uint8_t> frame(frame_size);
+  for (size_t i = 0; i < frame_size; i++) {
+    frame[i] = static_cast<uint8_t>(i);
+  }
+  ze_image_region_t region = {0, 0, 0, width, height, 1};
+  benchmark->commandListReset(command_list);
+  benchmark->commandListAppendImageCopyFromMemory(command_list, planar,
+                                                  frame.data(), &region);
+  benchmark->commandListClose(command_list);
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+
+  create_views(format, planar, views);
+
+  // Kernel reads the planes directly through the views
+  benchmark->commandListReset(command_list);
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    append_read(format, views);
+  }
+  benchmark->commandListClose(command_list);
+  result.view_frame_usec = run_frames();
+
+  // Planes are copied into separate images first, then read
+  std::vector<ze_image_handle_t> separate;
+  for (const plane_t &plane : format.planes) {
+    ze_image_desc_t plane_desc = image_desc(
+        plane.layout, width / plane.divisor, height / plane.divisor);
+    ze_image_handle_t image = nullptr;
+    benchmark->imageCreate(&plane_desc, &image);
+    separate.push_back(image);
+  }
+  benchmark->commandListReset(command_list);
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    for (size_t p = 0; p < separate.size(); p++) {
+      SUCCESS_OR_TERMINATE(zeCommandListAppendImageCopy(
+          command_list, separate[p], views[p], nullptr, 0, nullptr));
+    }
+    benchmark->commandListAppendBarrier(command_list);
+    append_read(format, separate);
+  }
+  benchmark->commandListClose(command_list);
+  result.copy_frame_usec = run_frames();
+
+  for (ze_image_handle_t image : separate) {
+    benchmark->imageDestroy(image);
+  }
+  for (ze_image_handle_t view : views) {
+    benchmark->imageDestroy(view);
+  }
+  benchmark->imageDestroy(planar);
+  return result;
+}
+
+void ZeImageView::report(const planar_format_t &format,
+                         const view_result_t &result) {
+  std::cout << std::left << std::setw(5) << format.name << std::right;
+  if (!result.supported) {
+    std::cout << ": not supported" << std::endl;
+    return;
+  }
+  long double pixels = static_cast<long double>(width) * height;
+  long double speedup = result.copy_frame_usec / result.view_frame_usec;
+  std::cout << ": view create = " << std::fixed << std::setprecision(2)
+            << std::setw(7) << result.create_usec
+            << " usec  destroy = " << std::setw(7) << result.destroy_usec
+            << " usec" << std::endl;
+  std::cout << "       read through views = " << std::setw(9)
+            << result.view_frame_usec << " usec/frame (" << std::setw(7)
+            << pixels / result.view_frame_usec / 1e3 << " Gpixels/s)"
+            << std::endl;
+  std::cout << "       copy planes + read = " << std::setw(9)
+            << result.copy_frame_usec << " usec/frame (" << std::setw(7)
+            << pixels / result.copy_frame_usec / 1e3 << " Gpixels/s)"
+            << "  views speedup = " << std::setprecision(3) << speedup << "x"
+            << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Image view");
+      test_ptree.put("Format", format.name);
+      test_ptree.put("Width", width);
+      test_ptree.put("Height", height);
+      test_ptree.put("View create(usec)", result.create_usec);
+      test_ptree.put("View destroy(usec)", result.destroy_usec);
+      test_ptree.put("Read through views(usec/frame)",
+                     result.view_frame_usec);
+      test_ptree.put("Copy planes and read(usec/frame)",
+                     result.copy_frame_usec);
+      test_ptree.put("Views speedup", speedup);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting image view measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void ZeImageView::run(void) {
+  benchmark->memoryAlloc(0, static_cast<size_t>(width) * height *
+                                sizeof(uint32_t),
+                         &output_buffer);
+
+  std::cout << "Frame: " << width << "x" << height << std::endl;
+  for (const planar_format_t &format : formats) {
+    report(format, measure(format));
+  }
+  std::cout << "-----------------------------------------------------"
+               "---------------------------\n";
+
+  benchmark->memoryFree(output_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.image_view", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeImageView image_view;
+  SUCCESS_OR_TERMINATE(image_view.parse_command_line(argc, argv));
+  if (!image_view.setup_environment()) {
+    return 1;
+  }
+  image_view.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
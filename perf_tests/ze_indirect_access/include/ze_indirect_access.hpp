@@ -0,0 +1,88 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_INDIRECT_ACCESS_HPP
+#define ZE_INDIRECT_ACCESS_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum access_mode_t {
+  MODE_EXPLICIT_ARGS = 0, /* every touched allocation is a kernel argument */
+  MODE_INDIRECT = 1,      /* pointer table, zeKernelSetIndirectAccess */
+  MODE_RESIDENT = 2,      /* pointer table, zeContextMakeMemoryResident */
+  MODE_COUNT = 3
+};
+
+enum allocation_type_t {
+  ALLOCATION_DEVICE = 0,
+  ALLOCATION_HOST = 1,
+  ALLOCATION_SHARED = 2
+};
+
+struct launch_result_t {
+  bool supported = false;
+  long double submit_usec = 0; /* zeCommandQueueExecuteCommandLists call */
+  long double total_usec = 0;  /* submission until the kernel completes */
+};
+
+class ZeIndirectAccess {
+public:
+  ZeIndirectAccess();
+  ~ZeIndirectAccess();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  uint32_t min_allocations = 10;
+  uint32_t max_allocations = 100000;
+  std::vector<allocation_type_t> allocation_types;
+  uint32_t work_items = 65536;
+  uint32_t number_iterations = 100;
+  bool report_rejected = false;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  static const uint32_t touched_allocations = 8;
+  static const size_t allocation_size = 4096;
+
+  std::vector<uint64_t> allocation_counts(void);
+  void *allocate(allocation_type_t type);
+  void fill_table(const std::vector<void *> &allocations);
+  launch_result_t measure(allocation_type_t type, access_mode_t mode,
+                          const std::vector<void *> &allocations);
+  void report(allocation_type_t type, size_t live_allocations,
+              access_mode_t mode, const launch_result_t &result);
+
+  ZeApp *benchmark;
+  ze_kernel_handle_t args_kernel = nullptr;
+  ze_kernel_handle_t table_kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+  void *table_buffer = nullptr;
+  void *output_buffer = nullptr;
+};
+
+#endif /* ZE_INDIRECT_ACCESS_HPP */
@@ -0,0 +1,30 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+/* Both kernels sum one element from each of eight 4096 byte allocations. */
+kernel void read_args(const global uint *p0, const global uint *p1,
+                      const global uint *p2, const global uint *p3,
+                      const global uint *p4, const global uint *p5,
+                      const global uint *p6, const global uint *p7,
+                      global uint *output) {
+  const size_t i = get_global_id(0);
+  const size_t j = i & 1023;
+  output[i] = p0[j] + p1[j] + p2[j] + p3[j] + p4[j] + p5[j] + p6[j] + p7[j];
+}
+
+/* The allocations are only reachable through the table, so the kernel needs
+   indirect access flags or explicitly resident memory. */
+kernel void read_table(const global ulong *table, global uint *output) {
+  const size_t i = get_global_id(0);
+  const size_t j = i & 1023;
+  uint sum = 0;
+  for (int k = 0; k < 8; k++) {
+    sum += ((const global uint *)table[k])[j];
+  }
+  output[i] = sum;
+}
@@ -0,0 +1,81 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_indirect_access.hpp"
+
+int ZeIndirectAccess::parse_command_line(int argc, char **argv) {
+
+  std::vector<std::string> types;
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "min-allocs", po::value<uint32_t>(&min_allocations)->default_value(10),
+        "set smallest number of live allocations, at least 8")(
+        "max-allocs",
+        po::value<uint32_t>(&max_allocations)->default_value(100000),
+        "set largest number of live allocations")(
+        "type",
+        po::value<std::vector<std::string>>(&types)
+            ->multitoken()
+            ->default_value({"device", "host", "shared"}, "device host shared"),
+        "set allocation types: device, host, shared")(
+        "work-items", po::value<uint32_t>(&work_items)->default_value(65536),
+        "set number of work-items per launch")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(100),
+        "set number of launches per measurement")(
+        "report-rejected", po::bool_switch(&report_rejected),
+        "print why the driver rejects a residency request")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  for (const std::string &type : types) {
+    if (type == "device") {
+      allocation_types.push_back(ALLOCATION_DEVICE);
+    } else if (type == "host") {
+      allocation_types.push_back(ALLOCATION_HOST);
+    } else if (type == "shared") {
+      allocation_types.push_back(ALLOCATION_SHARED);
+    } else {
+      std::cout << "unknown allocation type " << type << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  if (min_allocations < touched_allocations ||
+      max_allocations < min_allocations) {
+    std::cout << "live allocations must be between " << touched_allocations
+              << " and the maximum" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (work_items == 0 || number_iterations == 0) {
+    std::cout << "work-items and iterations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,281 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_indirect_access.hpp"
+
+static const char *mode_names[] = {"explicit arguments", "indirect access",
+                                   "explicit residency"};
+static const char *type_names[] = {"device", "host", "shared"};
+static const ze_kernel_indirect_access_flags_t indirect_flags[] = {
+    ZE_KERNEL_INDIRECT_ACCESS_FLAG_DEVICE, ZE_KERNEL_INDIRECT_ACCESS_FLAG_HOST,
+    ZE_KERNEL_INDIRECT_ACCESS_FLAG_SHARED};
+
+ZeIndirectAccess::ZeIndirectAccess() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_indirect_access.spv");
+  benchmark->singleDeviceInit();
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+
+  benchmark->functionCreate(&args_kernel, "read_args");
+  benchmark->functionCreate(&table_kernel, "read_table");
+}
+
+ZeIndirectAccess::~ZeIndirectAccess() {
+  benchmark->functionDestroy(args_kernel);
+  benchmark->functionDestroy(table_kernel);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeIndirectAccess::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeIndirectAccess::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+void *ZeIndirectAccess::allocate(allocation_type_t type) {
+  void *ptr = nullptr;
+
+  switch (type) {
+  case ALLOCATION_DEVICE:
+    benchmark->memoryAlloc(0, allocation_size, &ptr);
+    break;
+  case ALLOCATION_HOST:
+    benchmark->memoryAllocHost(allocation_size, &ptr);
+    break;
+  case ALLOCATION_SHARED:
+    benchmark->memoryAllocShared(0, allocation_size, &ptr);
+    break;
+  }
+  return ptr;
+}
+
+// The table holds the addresses of the touched allocations for read_table.
+void ZeIndirectAccess::fill_table(const std::vector<void *> &allocations) {
+  uint64_t table[touched_allocations];
+  for (uint32_t i = 0U; i < touched_allocations; i++) {
+    table[i] = reinterpret_cast<uint64_t>(allocations[i]);
+  }
+
+  benchmark->commandListReset(command_list);
+  benchmark->commandListAppendMemoryCopy(command_list, table_buffer, table,
+                                         sizeof(table));
+  benchmark->commandListClose(command_list);
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+}
+
+launch_result_t
+ZeIndirectAccess::measure(allocation_type_t type, access_mode_t mode,
+                          const std::vector<void *> &allocations) {
+  launch_result_t result;
+  ze_kernel_handle_t kernel = nullptr;
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+
+  switch (mode) {
+  case MODE_EXPLICIT_ARGS:
+    kernel = args_kernel;
+    for (uint32_t i = 0U; i < touched_allocations; i++) {
+      SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+          kernel, i, sizeof(allocations[i]), &allocations[i]));
+    }
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, touched_allocations, sizeof(output_buffer), &output_buffer));
+    break;
+  case MODE_INDIRECT:
+  case MODE_RESIDENT:
+    kernel = table_kernel;
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 0, sizeof(table_buffer), &table_buffer));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 1, sizeof(output_buffer), &output_buffer));
+    SUCCESS_OR_TERMINATE(zeKernelSetIndirectAccess(
+        kernel, mode == MODE_INDIRECT ? indirect_flags[type] : 0));
+    break;
+  default:
+    return result;
+  }
+
+  if (mode == MODE_RESIDENT) {
+    for (uint32_t i = 0U; i < touched_allocations; i++) {
+      ze_result_t resident = zeContextMakeMemoryResident(
+          benchmark->context, benchmark->_devices[0], allocations[i],
+          allocation_size);
+      if (resident != ZE_RESULT_SUCCESS) {
+        if (report_rejected) {
+          std::cerr << "WARNING : zeContextMakeMemoryResident : " << resident
+                    << std::endl;
+        }
+        for (uint32_t j = 0U; j < i; j++) {
+          SUCCESS_OR_TERMINATE(zeContextEvictMemory(
+              benchmark->context, benchmark->_devices[0], allocations[j],
+              allocation_size));
+        }
+        return result;
+      }
+    }
+  }
+
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+      kernel, work_items, 1, 1, &group_size_x, &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, group_size_x, 1, 1));
+  ze_group_count_t group_count = {work_items / group_size_x, 1, 1};
+
+  benchmark->commandListReset(command_list);
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      command_list, kernel, &group_count, nullptr, 0, nullptr));
+  benchmark->commandListClose(command_list);
+
+  // Warm up
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+
+  result.supported = true;
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    Timer<std::chrono::microseconds::period> submit_timer;
+    Timer<std::chrono::microseconds::period> total_timer;
+
+    total_timer.start();
+    submit_timer.start();
+    SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+        command_queue, 1, &command_list, nullptr));
+    submit_timer.end();
+    SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+    total_timer.end();
+
+    result.submit_usec += submit_timer.period_minus_overhead();
+    result.total_usec += total_timer.period_minus_overhead();
+  }
+  result.submit_usec /= number_iterations;
+  result.total_usec /= number_iterations;
+
+  if (mode == MODE_RESIDENT) {
+    for (uint32_t i = 0U; i < touched_allocations; i++) {
+      SUCCESS_OR_TERMINATE(
+          zeContextEvictMemory(benchmark->context, benchmark->_devices[0],
+                               allocations[i], allocation_size));
+    }
+  }
+  return result;
+}
+
+void ZeIndirectAccess::report(allocation_type_t type, size_t live_allocations,
+                              access_mode_t mode,
+                              const launch_result_t &result) {
+  std::cout << "[" << std::left << std::setw(6) << type_names[type] << "]["
+            << std::right << std::setw(6) << live_allocations << " allocs]["
+            << std::left << std::setw(18) << mode_names[mode] << "]"
+            << std::right << ":";
+  if (!result.supported) {
+    std::cout << "  not supported" << std::endl;
+    return;
+  }
+  std::cout << "  submit = " << std::fixed << std::setprecision(2)
+            << std::setw(9) << result.submit_usec
+            << " usec  total = " << std::setw(9) << result.total_usec
+            << " usec" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Indirect access");
+      test_ptree.put("Allocation type", type_names[type]);
+      test_ptree.put("Live allocations", live_allocations);
+      test_ptree.put("Mode", mode_names[mode]);
+      test_ptree.put("Submit(usec)", result.submit_usec);
+      test_ptree.put("Total(usec)", result.total_usec);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting indirect access measurement: "
+                << e.what() << std::endl;
+    }
+  }
+}
+
+// The live allocation count grows by 10x from min_allocations, and ends
+// with max_allocations even when it is not min_allocations times a power
+// of 10.
+std::vector<uint64_t> ZeIndirectAccess::allocation_counts(void) {
+  std::vector<uint64_t> counts;
+  for (uint64_t count = min_allocations; count < max_allocations;
+       count *= 10) {
+    counts.push_back(count);
+  }
+  counts.push_back(max_allocations);
+  return counts;
+}
+
+void ZeIndirectAccess::run(void) {
+  benchmark->memoryAlloc(0, touched_allocations * sizeof(uint64_t),
+                         &table_buffer);
+  benchmark->memoryAlloc(0, work_items * sizeof(uint32_t), &output_buffer);
+
+  for (allocation_type_t type : allocation_types) {
+    std::vector<void *> allocations;
+
+    // The kernel keeps touching the first few allocations only.
+    for (uint64_t count : allocation_counts()) {
+      while (allocations.size() < count) {
+        allocations.push_back(allocate(type));
+      }
+      if (count == min_allocations) {
+        fill_table(allocations);
+      }
+      for (int m = 0; m < MODE_COUNT; m++) {
+        access_mode_t mode = static_cast<access_mode_t>(m);
+        report(type, allocations.size(), mode,
+               measure(type, mode, allocations));
+      }
+    }
+
+    for (void *ptr : allocations) {
+      benchmark->memoryFree(ptr);
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->memoryFree(table_buffer);
+  benchmark->memoryFree(output_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.indirect_access",
+                           param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeIndirectAccess indirect_access;
+  SUCCESS_OR_TERMINATE(indirect_access.parse_command_line(argc, argv));
+  if (!indirect_access.setup_environment()) {
+    return 1;
+  }
+  indirect_access.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_MADVISE_HPP
+#define ZE_MADVISE_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+#include "ze_sample_stats.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum access_pattern_t {
+  PATTERN_DEVICE_READ = 0,   /* kernel reads the shared allocation */
+  PATTERN_DEVICE_WRITE = 1,  /* kernel writes the shared allocation */
+  PATTERN_DEVICE_UPDATE = 2, /* kernel reads and writes it */
+  PATTERN_PING_PONG = 3,     /* host writes, kernel updates, host reads */
+  PATTERN_COPY_TO_DEVICE = 4,
+  PATTERN_COPY_FROM_DEVICE = 5,
+  PATTERN_COUNT = 6
+};
+
+struct advice_t {
+  std::string name;
+  bool none;                 /* baseline without any advice */
+  ze_memory_advice_t advice; /* unused for the baseline */
+  uint32_t device_index;     /* device passed to zeCommandListAppendMemAdvise */
+};
+
+struct advice_result_t {
+  bool supported = false;
+  long double first_usec = 0;  /* first iteration after the advice */
+  long double steady_usec = 0; /* average of the following iterations */
+  ZeSampleStats steady;       /* the following iterations */
+};
+
+class ZeMadvise {
+public:
+  ZeMadvise();
+  ~ZeMadvise();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<size_t> working_set_sizes;
+  uint32_t number_iterations = 20;
+  bool report_rejected = false;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  bool apply_advice(const advice_t &advice, void *ptr, size_t size);
+  void record_pattern(access_pattern_t pattern, void *shared, size_t size);
+  long double run_iteration(access_pattern_t pattern, void *shared,
+                            size_t size);
+  advice_result_t measure(access_pattern_t pattern, const advice_t &advice,
+                          size_t size);
+  void report(access_pattern_t pattern, size_t size,
+              const std::vector<advice_result_t> &results);
+
+  ZeApp *benchmark;
+  std::vector<advice_t> advices;
+  ze_kernel_handle_t read_kernel = nullptr;
+  ze_kernel_handle_t write_kernel = nullptr;
+  ze_kernel_handle_t update_kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+  ze_command_list_handle_t advice_list = nullptr;
+  void *device_buffer = nullptr;
+  void *sink_buffer = nullptr;
+};
+
+#endif /* ZE_MADVISE_HPP */
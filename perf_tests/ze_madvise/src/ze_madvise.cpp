@@ -0,0 +1,289 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_madvise.hpp"
+
+#include <algorithm>
+
+static const char *pattern_names[] = {
+    "device read",    "device write",   "device update",
+    "host ping-pong", "copy to device", "copy from device"};
+
+static const size_t sink_size = 256 * 16;
+
+ZeMadvise::ZeMadvise() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_memory_access.spv");
+  uint32_t device_count = benchmark->allDevicesInit();
+
+  advices.push_back({"none", true, ZE_MEMORY_ADVICE_FORCE_UINT32, 0});
+  advices.push_back(
+      {"read mostly", false, ZE_MEMORY_ADVICE_SET_READ_MOSTLY, 0});
+  advices.push_back({"preferred location device", false,
+                     ZE_MEMORY_ADVICE_SET_PREFERRED_LOCATION, 0});
+  advices.push_back({"preferred location system", false,
+                     ZE_MEMORY_ADVICE_SET_SYSTEM_MEMORY_PREFERRED_LOCATION,
+                     0});
+  advices.push_back(
+      {"non atomic mostly", false, ZE_MEMORY_ADVICE_SET_NON_ATOMIC_MOSTLY, 0});
+  advices.push_back({"bias cached", false, ZE_MEMORY_ADVICE_BIAS_CACHED, 0});
+  advices.push_back(
+      {"bias uncached", false, ZE_MEMORY_ADVICE_BIAS_UNCACHED, 0});
+  // Remote placement hint: work runs on device 0, memory prefers device 1.
+  if (device_count > 1) {
+    advices.push_back({"preferred location remote device", false,
+                       ZE_MEMORY_ADVICE_SET_PREFERRED_LOCATION, 1});
+  }
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+  benchmark->commandListCreate(0, ordinal, &advice_list);
+
+  benchmark->functionCreate(&read_kernel, "read_data");
+  benchmark->functionCreate(&write_kernel, "write_data");
+  benchmark->functionCreate(&update_kernel, "read_write_data");
+}
+
+ZeMadvise::~ZeMadvise() {
+  benchmark->functionDestroy(read_kernel);
+  benchmark->functionDestroy(write_kernel);
+  benchmark->functionDestroy(update_kernel);
+  benchmark->commandListDestroy(advice_list);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->allDevicesCleanup();
+
+  delete benchmark;
+}
+
+bool ZeMadvise::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeMadvise::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+// Returns false if the driver rejects the advice. The baseline appends no
+// advice at all.
+bool ZeMadvise::apply_advice(const advice_t &advice, void *ptr, size_t size) {
+  if (advice.none) {
+    return true;
+  }
+  benchmark->commandListReset(advice_list);
+  ze_result_t result = zeCommandListAppendMemAdvise(
+      advice_list, benchmark->_devices[advice.device_index], ptr, size,
+      advice.advice);
+  if (result != ZE_RESULT_SUCCESS) {
+    if (report_rejected) {
+      std::cerr << "WARNING : zeCommandListAppendMemAdvise(" << advice.name
+                << ") : " << result << std::endl;
+    }
+    return false;
+  }
+  benchmark->commandListClose(advice_list);
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &advice_list);
+  benchmark->commandQueueSynchronize(command_queue);
+  return true;
+}
+
+void ZeMadvise::record_pattern(access_pattern_t pattern, void *shared,
+                               size_t size) {
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+  uint32_t elements = static_cast<uint32_t>(size / 16);
+  const uint32_t value = 0x5a5a5a5a;
+  ze_kernel_handle_t kernel = nullptr;
+
+  benchmark->commandListReset(command_list);
+  switch (pattern) {
+  case PATTERN_DEVICE_READ:
+    kernel = read_kernel;
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(shared), &shared));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(kernel, 1,
+                                                  sizeof(sink_buffer),
+                                                  &sink_buffer));
+    break;
+  case PATTERN_DEVICE_WRITE:
+    kernel = write_kernel;
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(shared), &shared));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 1, sizeof(value), &value));
+    break;
+  case PATTERN_DEVICE_UPDATE:
+  case PATTERN_PING_PONG:
+    kernel = update_kernel;
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(shared), &shared));
+    break;
+  case PATTERN_COPY_TO_DEVICE:
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+        command_list, device_buffer, shared, size, nullptr, 0, nullptr));
+    break;
+  case PATTERN_COPY_FROM_DEVICE:
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+        command_list, shared, device_buffer, size, nullptr, 0, nullptr));
+    break;
+  default:
+    break;
+  }
+
+  if (kernel) {
+    SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+        kernel, elements, 1, 1, &group_size_x, &group_size_y, &group_size_z));
+    SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, group_size_x, 1, 1));
+    ze_group_count_t group_count = {elements / group_size_x, 1, 1};
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        command_list, kernel, &group_count, nullptr, 0, nullptr));
+  }
+  benchmark->commandListClose(command_list);
+}
+
+long double ZeMadvise::run_iteration(access_pattern_t pattern, void *shared,
+                                     size_t size) {
+  Timer<std::chrono::microseconds::period> timer;
+  volatile uint64_t checksum = 0;
+
+  timer.start();
+  if (pattern == PATTERN_PING_PONG) {
+    memset(shared, 1, size);
+  }
+  SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+      command_queue, 1, &command_list, nullptr));
+  SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+  if (pattern == PATTERN_PING_PONG) {
+    const uint64_t *data = static_cast<const uint64_t *>(shared);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size / sizeof(uint64_t); i++) {
+      sum += data[i];
+    }
+    checksum = sum;
+  }
+  timer.end();
+
+  (void)checksum;
+  return timer.period_minus_overhead();
+}
+
+// Every measurement uses a fresh shared allocation first touched on the
+// host, so no placement is left over from a previous advice.
+advice_result_t ZeMadvise::measure(access_pattern_t pattern,
+                                   const advice_t &advice, size_t size) {
+  advice_result_t result;
+  void *shared = nullptr;
+
+  benchmark->memoryAllocShared(0, size, &shared);
+  memset(shared, 0, size);
+
+  if (apply_advice(advice, shared, size)) {
+    record_pattern(pattern, shared, size);
+
+    result.supported = true;
+    result.first_usec = run_iteration(pattern, shared, size);
+    for (uint32_t i = 0U; i < number_iterations; i++) {
+      result.steady.add(run_iteration(pattern, shared, size));
+    }
+    result.steady_usec = result.steady.mean;
+  }
+
+  benchmark->memoryFree(shared);
+  return result;
+}
+
+void ZeMadvise::report(access_pattern_t pattern, size_t size,
+                       const std::vector<advice_result_t> &results) {
+  const advice_result_t &baseline = results[0];
+
+  std::cout << "Pattern: " << pattern_names[pattern]
+            << "  Working set: " << size << " bytes" << std::endl;
+  for (size_t a = 0; a < advices.size(); a++) {
+    const advice_result_t &result = results[a];
+    std::cout << "\t" << std::left << std::setw(33) << advices[a].name
+              << std::right << ":";
+    if (!result.supported) {
+      std::cout << "  not supported" << std::endl;
+      continue;
+    }
+    long double speedup = baseline.steady_usec / result.steady_usec;
+    std::cout << "  first = " << std::fixed << std::setw(11)
+              << std::setprecision(2) << result.first_usec
+              << " usec  steady = " << std::setw(11) << result.steady_usec
+              << " usec  speedup = " << std::setprecision(3) << speedup << "x"
+              << std::endl;
+
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "Memory advice");
+        test_ptree.put("Pattern", pattern_names[pattern]);
+        test_ptree.put("Advice", advices[a].name);
+        test_ptree.put("Size", size);
+        test_ptree.put("First iteration(usec)", result.first_usec);
+        test_ptree.put("Steady state(usec)", result.steady_usec);
+        result.steady.add_to(test_ptree, "Steady state(usec)");
+        test_ptree.put("Speedup", speedup);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting memory advice measurement: "
+                  << e.what() << std::endl;
+      }
+    }
+  }
+}
+
+void ZeMadvise::run(void) {
+  size_t max_size =
+      *std::max_element(working_set_sizes.begin(), working_set_sizes.end());
+  benchmark->memoryAlloc(0, max_size, &device_buffer);
+  benchmark->memoryAlloc(0, sink_size, &sink_buffer);
+
+  for (size_t size : working_set_sizes) {
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+      access_pattern_t pattern = static_cast<access_pattern_t>(p);
+      std::vector<advice_result_t> results;
+      for (const advice_t &advice : advices) {
+        results.push_back(measure(pattern, advice, size));
+      }
+      report(pattern, size, results);
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->memoryFree(device_buffer);
+  benchmark->memoryFree(sink_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.madvise", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeMadvise madvise;
+  SUCCESS_OR_TERMINATE(madvise.parse_command_line(argc, argv));
+  if (!madvise.setup_environment()) {
+    return 1;
+  }
+  madvise.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_MULTICONTEXT_HPP
+#define ZE_MULTICONTEXT_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+/* Work submitted by one tenant: a copy and a kernel per iteration. */
+struct tenant_t {
+  ZeApp *app = nullptr;
+  uint32_t compute_ordinal = 0;
+  uint32_t copy_ordinal = 0;
+  ze_command_queue_handle_t compute_queue = nullptr;
+  ze_command_queue_handle_t copy_queue = nullptr;
+  ze_command_list_handle_t compute_list = nullptr;
+  ze_command_list_handle_t copy_list = nullptr;
+  ze_kernel_handle_t kernel = nullptr;
+  void *copy_src = nullptr;
+  void *copy_dst = nullptr;
+  void *kernel_data = nullptr;
+  /* Completion time of every timed iteration */
+  std::vector<std::chrono::steady_clock::time_point> completions;
+  /* Iterations completed while every tenant was running */
+  uint32_t window_iterations = 0;
+};
+
+class ZeMultiContext {
+public:
+  ZeMultiContext();
+  ~ZeMultiContext();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void measure_cross_context_copy(void);
+  void measure_contention(void);
+  void write_json(void);
+
+  std::vector<size_t> transfer_sizes;
+  size_t min_size = 4096;
+  size_t max_size = (1 << 26);
+  size_t tenant_copy_size = (1 << 24);
+  uint32_t tenant_kernel_elements = (1 << 22);
+  uint32_t max_contexts = 8;
+  uint32_t number_iterations = 100;
+  uint32_t warmup_iterations = 10;
+  bool run_cross_context = true;
+  bool run_contention = true;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree copy_array;
+  ptree contention_array;
+
+private:
+  void create_contexts(uint32_t count);
+  long double measure_copy(ZeApp *app, ze_command_queue_handle_t queue,
+                           ze_command_list_handle_t list, void *dst,
+                           ze_context_handle_t src_context, void *src,
+                           size_t size);
+  void setup_tenant(tenant_t &tenant, ZeApp *app);
+  void cleanup_tenant(tenant_t &tenant);
+  long double run_tenants(std::vector<tenant_t> &tenants);
+  void report_contention(const std::string &mode,
+                         const std::vector<tenant_t> &tenants,
+                         long double window_usec);
+
+  /* One ZeApp per context, apps[0] is the reference context. */
+  std::vector<ZeApp *> apps;
+};
+
+#endif /* ZE_MULTICONTEXT_HPP */
@@ -0,0 +1,12 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+kernel void scale_add(global float *data, float a, float b) {
+  const size_t i = get_global_id(0);
+  data[i] = data[i] * a + b;
+}
@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_multicontext.hpp"
+
+int ZeMultiContext::parse_command_line(int argc, char **argv) {
+
+  std::string test = "all";
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "test", po::value<std::string>(&test)->default_value("all"),
+        "run cross context copies (copy), multi-context contention "
+        "(contention) or both (all)")(
+        "min-size", po::value<size_t>(&min_size)->default_value(4096),
+        "set smallest cross context transfer size in bytes")(
+        "max-size", po::value<size_t>(&max_size)->default_value(1 << 26),
+        "set largest cross context transfer size in bytes, sizes grow by a "
+        "factor of 4")(
+        "contexts", po::value<uint32_t>(&max_contexts)->default_value(8),
+        "set largest number of concurrently submitting contexts")(
+        "copy-size",
+        po::value<size_t>(&tenant_copy_size)->default_value(1 << 24),
+        "set bytes copied per iteration by every context")(
+        "kernel-elements",
+        po::value<uint32_t>(&tenant_kernel_elements)->default_value(1 << 22),
+        "set elements processed per kernel launch by every context")(
+        "warmup", po::value<uint32_t>(&warmup_iterations)->default_value(10),
+        "set number of warmup operations")(
+        "num-iter",
+        po::value<uint32_t>(&number_iterations)->default_value(100),
+        "set number of iterations")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  run_cross_context = (test == "copy" || test == "all");
+  run_contention = (test == "contention" || test == "all");
+
+  if (!run_cross_context && !run_contention) {
+    std::cout << "unknown test " << test << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (min_size == 0 || min_size > max_size) {
+    std::cout << "invalid transfer size range" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (max_contexts == 0 || number_iterations == 0 ||
+             tenant_kernel_elements == 0) {
+    std::cout << "number of contexts, iterations and kernel elements must be "
+                 "greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  transfer_sizes.clear();
+  for (size_t size = min_size; size < max_size; size *= 4) {
+    transfer_sizes.push_back(size);
+  }
+  transfer_sizes.push_back(max_size);
+
+  return 0;
+}
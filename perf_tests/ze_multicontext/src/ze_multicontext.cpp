@@ -0,0 +1,408 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_multicontext.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+ZeMultiContext::ZeMultiContext() {}
+
+ZeMultiContext::~ZeMultiContext() {
+  for (ZeApp *app : apps) {
+    app->singleDeviceCleanup();
+    delete app;
+  }
+}
+
+bool ZeMultiContext::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeMultiContext::setup_environment(void) {
+  create_contexts(1);
+  return env_guard.setup(apps[0]->_devices[0]);
+}
+
+// Every ZeApp owns one context on the first device.
+void ZeMultiContext::create_contexts(uint32_t count) {
+  while (apps.size() < count) {
+    ZeApp *app = new ZeApp("ze_multicontext.spv");
+    app->singleDeviceInit();
+    apps.push_back(app);
+  }
+}
+
+// Returns the average latency of one copy recorded in list. A non-null
+// src_context makes it a copy from another context.
+long double ZeMultiContext::measure_copy(ZeApp *app,
+                                         ze_command_queue_handle_t queue,
+                                         ze_command_list_handle_t list,
+                                         void *dst,
+                                         ze_context_handle_t src_context,
+                                         void *src, size_t size) {
+  Timer<std::chrono::microseconds::period> timer;
+
+  app->commandListReset(list);
+  if (src_context) {
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopyFromContext(
+        list, dst, src_context, src, size, nullptr, 0, nullptr));
+  } else {
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(list, dst, src, size,
+                                                       nullptr, 0, nullptr));
+  }
+  app->commandListClose(list);
+
+  for (uint32_t i = 0U; i < warmup_iterations; i++) {
+    app->commandQueueExecuteCommandList(queue, 1, &list);
+    app->commandQueueSynchronize(queue);
+  }
+
+  timer.start();
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    SUCCESS_OR_TERMINATE(
+        zeCommandQueueExecuteCommandLists(queue, 1, &list, nullptr));
+    SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(queue, UINT64_MAX));
+  }
+  timer.end();
+
+  return timer.period_minus_overhead() / number_iterations;
+}
+
+// Copies into device memory of the reference context, once from a buffer of
+// the same context and once from an equivalent buffer of a second context.
+void ZeMultiContext::measure_cross_context_copy(void) {
+  create_contexts(2);
+  ZeApp *local = apps[0];
+  ZeApp *remote = apps[1];
+  uint32_t ordinal = 0;
+  ze_command_queue_handle_t queue;
+  ze_command_list_handle_t list;
+
+  if (!local->queueGroupOrdinal(0, true, &ordinal)) {
+    local->queueGroupOrdinal(0, false, &ordinal);
+  }
+  local->commandQueueCreate(0, ordinal, &queue);
+  local->commandListCreate(0, ordinal, &list);
+
+  void *dst = nullptr;
+  local->memoryAlloc(0, max_size, &dst);
+
+  for (bool host_source : {false, true}) {
+    void *local_src = nullptr;
+    void *remote_src = nullptr;
+    if (host_source) {
+      local->memoryAllocHost(max_size, &local_src);
+      remote->memoryAllocHost(max_size, &remote_src);
+    } else {
+      local->memoryAlloc(0, max_size, &local_src);
+      remote->memoryAlloc(0, max_size, &remote_src);
+    }
+    std::string source = host_source ? "host" : "device";
+
+    std::cout << "Copy from " << source
+              << " memory to device memory, same vs. cross context"
+              << std::endl;
+    for (size_t size : transfer_sizes) {
+      long double same_usec =
+          measure_copy(local, queue, list, dst, nullptr, local_src, size);
+      long double cross_usec = measure_copy(local, queue, list, dst,
+                                            remote->context, remote_src, size);
+      long double same_gbps =
+          static_cast<long double>(size) / ONE_GB / (same_usec / 1e6);
+      long double cross_gbps =
+          static_cast<long double>(size) / ONE_GB / (cross_usec / 1e6);
+      long double overhead = (cross_usec - same_usec) / same_usec * 100;
+
+      std::cout << "\t[" << std::setw(10) << size << "]:  same = " << std::fixed
+                << std::setw(9) << std::setprecision(2) << same_usec
+                << " usec " << std::setw(8) << std::setprecision(3)
+                << same_gbps << " GBPS  cross = " << std::setw(9)
+                << std::setprecision(2) << cross_usec << " usec "
+                << std::setw(8) << std::setprecision(3) << cross_gbps
+                << " GBPS  overhead = " << std::setw(7)
+                << std::setprecision(2) << overhead << " %" << std::endl;
+
+      if (is_json_output_enabled()) {
+        try {
+          ptree test_ptree;
+          test_ptree.put("Name", "Cross context copy");
+          test_ptree.put("Source", source);
+          test_ptree.put("Size", size);
+          test_ptree.put("Same context latency(usec)", same_usec);
+          test_ptree.put("Same context GBPS", same_gbps);
+          test_ptree.put("Cross context latency(usec)", cross_usec);
+          test_ptree.put("Cross context GBPS", cross_gbps);
+          test_ptree.put("Overhead(%)", overhead);
+          copy_array.push_back(std::make_pair("", test_ptree));
+        } catch (const std::exception &e) {
+          std::cerr << "Error outputting cross context copy measurement: "
+                    << e.what() << std::endl;
+        }
+      }
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+
+    local->memoryFree(local_src);
+    remote->memoryFree(remote_src);
+  }
+
+  local->memoryFree(dst);
+  local->commandListDestroy(list);
+  local->commandQueueDestroy(queue);
+}
+
+void ZeMultiContext::setup_tenant(tenant_t &tenant, ZeApp *app) {
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+  const float scale = 1.0f;
+  const float offset = 0.0f;
+
+  tenant.app = app;
+  app->queueGroupOrdinal(0, false, &tenant.compute_ordinal);
+  if (!app->queueGroupOrdinal(0, true, &tenant.copy_ordinal)) {
+    tenant.copy_ordinal = tenant.compute_ordinal;
+  }
+
+  app->commandQueueCreate(0, tenant.compute_ordinal, &tenant.compute_queue);
+  app->commandListCreate(0, tenant.compute_ordinal, &tenant.compute_list);
+  app->commandQueueCreate(0, tenant.copy_ordinal, &tenant.copy_queue);
+  app->commandListCreate(0, tenant.copy_ordinal, &tenant.copy_list);
+
+  app->memoryAlloc(0, tenant_copy_size, &tenant.copy_src);
+  app->memoryAlloc(0, tenant_copy_size, &tenant.copy_dst);
+  app->memoryAlloc(0, tenant_kernel_elements * sizeof(float),
+                   &tenant.kernel_data);
+
+  SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+      tenant.copy_list, tenant.copy_dst, tenant.copy_src, tenant_copy_size,
+      nullptr, 0, nullptr));
+  app->commandListClose(tenant.copy_list);
+
+  app->functionCreate(&tenant.kernel, "scale_add");
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+      tenant.kernel, tenant_kernel_elements, 1, 1, &group_size_x,
+      &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetGroupSize(tenant.kernel, group_size_x, 1, 1));
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      tenant.kernel, 0, sizeof(tenant.kernel_data), &tenant.kernel_data));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetArgumentValue(tenant.kernel, 1, sizeof(scale), &scale));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetArgumentValue(tenant.kernel, 2, sizeof(offset), &offset));
+  ze_group_count_t group_count = {tenant_kernel_elements / group_size_x, 1,
+                                  1};
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      tenant.compute_list, tenant.kernel, &group_count, nullptr, 0, nullptr));
+  app->commandListClose(tenant.compute_list);
+}
+
+void ZeMultiContext::cleanup_tenant(tenant_t &tenant) {
+  ZeApp *app = tenant.app;
+  app->functionDestroy(tenant.kernel);
+  app->memoryFree(tenant.copy_src);
+  app->memoryFree(tenant.copy_dst);
+  app->memoryFree(tenant.kernel_data);
+  app->commandListDestroy(tenant.compute_list);
+  app->commandListDestroy(tenant.copy_list);
+  app->commandQueueDestroy(tenant.compute_queue);
+  app->commandQueueDestroy(tenant.copy_queue);
+}
+
+//---------------------------------------------------------------------
+// Every tenant warms up, then waits until all of them are ready so they are
+// released together. Returns the length in usec of the common window, from
+// the release to the first tenant done, the only part of the run where all
+// the tenants overlap, and sets the iterations each one completed in it.
+//---------------------------------------------------------------------
+long double ZeMultiContext::run_tenants(std::vector<tenant_t> &tenants) {
+  std::atomic<uint32_t> ready{0U};
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+
+  for (tenant_t &tenant : tenants) {
+    threads.emplace_back([&, this]() {
+      for (uint32_t i = 0U; i < warmup_iterations; i++) {
+        SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+            tenant.copy_queue, 1, &tenant.copy_list, nullptr));
+        SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+            tenant.compute_queue, 1, &tenant.compute_list, nullptr));
+        SUCCESS_OR_TERMINATE(
+            zeCommandQueueSynchronize(tenant.copy_queue, UINT64_MAX));
+        SUCCESS_OR_TERMINATE(
+            zeCommandQueueSynchronize(tenant.compute_queue, UINT64_MAX));
+      }
+      tenant.completions.clear();
+      tenant.completions.reserve(number_iterations);
+
+      ready++;
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+
+      for (uint32_t i = 0U; i < number_iterations; i++) {
+        SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+            tenant.copy_queue, 1, &tenant.copy_list, nullptr));
+        SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+            tenant.compute_queue, 1, &tenant.compute_list, nullptr));
+        SUCCESS_OR_TERMINATE(
+            zeCommandQueueSynchronize(tenant.copy_queue, UINT64_MAX));
+        SUCCESS_OR_TERMINATE(
+            zeCommandQueueSynchronize(tenant.compute_queue, UINT64_MAX));
+        tenant.completions.push_back(std::chrono::steady_clock::now());
+      }
+    });
+  }
+
+  while (ready.load() < tenants.size()) {
+    std::this_thread::yield();
+  }
+  const auto release = std::chrono::steady_clock::now();
+  start.store(true);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  auto window_end = tenants[0].completions.back();
+  for (const tenant_t &tenant : tenants) {
+    window_end = std::min(window_end, tenant.completions.back());
+  }
+  for (tenant_t &tenant : tenants) {
+    tenant.window_iterations = static_cast<uint32_t>(
+        std::upper_bound(tenant.completions.begin(), tenant.completions.end(),
+                         window_end) -
+        tenant.completions.begin());
+  }
+  return std::chrono::duration<long double, std::micro>(window_end - release)
+      .count();
+}
+
+void ZeMultiContext::report_contention(const std::string &mode,
+                                       const std::vector<tenant_t> &tenants,
+                                       long double window_usec) {
+  uint32_t fewest = tenants[0].window_iterations;
+  uint32_t most = 0;
+  long double iterations = 0;
+  for (const tenant_t &tenant : tenants) {
+    fewest = std::min(fewest, tenant.window_iterations);
+    most = std::max(most, tenant.window_iterations);
+    iterations += tenant.window_iterations;
+  }
+
+  long double seconds = window_usec / 1e6;
+  long double copy_gbps =
+      iterations * static_cast<long double>(tenant_copy_size) / ONE_GB /
+      seconds;
+  long double kernels_per_second = iterations / seconds;
+  long double fairness = static_cast<long double>(fewest) / most;
+
+  std::cout << "[" << std::left << std::setw(17) << mode << std::right << "]["
+            << std::setw(3) << tenants.size()
+            << " contexts]:  Copy = " << std::fixed << std::setw(9)
+            << std::setprecision(3) << copy_gbps
+            << " GBPS  Kernels = " << std::setw(10) << std::setprecision(1)
+            << kernels_per_second << " /s  Fairness = "
+            << std::setprecision(3) << fairness << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Multi-context contention");
+      test_ptree.put("Mode", mode);
+      test_ptree.put("Contexts", tenants.size());
+      test_ptree.put("Copy GBPS", copy_gbps);
+      test_ptree.put("Kernels per second", kernels_per_second);
+      test_ptree.put("Fairness", fairness);
+      contention_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting contention measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// N tenants submit the same copy and compute work concurrently, either
+// through their own queues in one shared context or each in its own context,
+// so the cost of separate contexts can be told apart from queue contention.
+void ZeMultiContext::measure_contention(void) {
+  create_contexts(max_contexts);
+
+  std::vector<uint32_t> tenant_counts;
+  for (uint32_t count = 1; count < max_contexts; count *= 2) {
+    tenant_counts.push_back(count);
+  }
+  tenant_counts.push_back(max_contexts);
+
+  std::cout << "Concurrent copy of " << tenant_copy_size
+            << " bytes and kernel over " << tenant_kernel_elements
+            << " elements per tenant" << std::endl;
+  for (uint32_t count : tenant_counts) {
+    for (bool separate_contexts : {false, true}) {
+      std::vector<tenant_t> tenants(count);
+      for (uint32_t i = 0U; i < count; i++) {
+        setup_tenant(tenants[i], separate_contexts ? apps[i] : apps[0]);
+      }
+
+      long double window_usec = run_tenants(tenants);
+      report_contention(separate_contexts ? "separate contexts"
+                                          : "shared context",
+                        tenants, window_usec);
+
+      for (tenant_t &tenant : tenants) {
+        cleanup_tenant(tenant);
+      }
+    }
+  }
+  std::cout << "-----------------------------------------------------"
+               "---------------------------\n";
+}
+
+void ZeMultiContext::write_json(void) {
+  if (!is_json_output_enabled()) {
+    return;
+  }
+  try {
+    ptree ptree_main;
+    if (run_cross_context) {
+      ptree_main.put_child("Performance Benchmark.cross_context_copy",
+                           copy_array);
+    }
+    if (run_contention) {
+      ptree_main.put_child("Performance Benchmark.contention",
+                           contention_array);
+    }
+    env_guard.add_to(ptree_main);
+    pt::write_json(JsonFileName.c_str(), ptree_main);
+  } catch (const std::exception &e) {
+    std::cerr << "Error writing json output: " << e.what() << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeMultiContext multi_context;
+  SUCCESS_OR_TERMINATE(multi_context.parse_command_line(argc, argv));
+  if (!multi_context.setup_environment()) {
+    return 1;
+  }
+
+  if (multi_context.run_cross_context) {
+    multi_context.measure_cross_context_copy();
+  }
+  if (multi_context.run_contention) {
+    multi_context.measure_contention();
+  }
+  multi_context.write_json();
+
+  std::cout << std::flush;
+
+  return 0;
+}
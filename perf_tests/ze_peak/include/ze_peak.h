@@ -94,6 +94,21 @@ struct L0Context {
   void ze_peak_query_engines();
 };
 
+/* One roof of the roofline: GFLOPS of a precision or GB/s of a memory level */
+struct RooflineCeiling {
+  std::string name;
+  long double value;
+};
+
+/* A kernel placed on the roofline from its FLOPs, bytes and run time */
+struct RooflineKernel {
+  std::string name;
+  long double flops;
+  long double bytes;
+  long double usec;
+  std::string precision; /* compute ceiling the kernel is bound by */
+};
+
 struct ZeWorkGroups {
   ze_group_count_t thread_group_dimensions;
   uint32_t group_size_x;
@@ -112,6 +127,7 @@ public:
   bool run_int_compute = true;
   bool run_transfer_bw = true;
   bool run_kernel_lat = true;
+  bool run_roofline = false;
   bool enable_explicit_scaling = false;
   bool query_engines = false;
   bool enable_fixed_ordinal_index = false;
@@ -124,6 +140,11 @@ public:
   uint32_t current_sub_device_id = 0;
   uint32_t command_queue_group_ordinal = 0;
   uint32_t command_queue_index = 0;
+  std::string roofline_kernels_file;
+  std::string roofline_output = "ze_peak_roofline";
+  std::string roofline_level = "global";
+  std::vector<RooflineCeiling> compute_ceilings;
+  std::vector<RooflineCeiling> bandwidth_ceilings;
 
   int parse_arguments(int argc, char **argv);
 
@@ -140,6 +161,9 @@ public:
                       size_t outputSize = 0u);
   uint64_t get_max_work_items(L0Context &context);
   void print_test_complete();
+  void record_compute_ceiling(const std::string &precision,
+                              long double gflops);
+  void record_bandwidth_ceiling(long double gbps);
   void run_command_queue(L0Context &context);
   void synchronize_command_queue(L0Context &context);
   /* Benchmark Functions*/
@@ -148,6 +172,9 @@ public:
   void ze_peak_hp_compute(L0Context &context);
   void ze_peak_sp_compute(L0Context &context);
   void ze_peak_transfer_bw(L0Context &context);
+  void ze_peak_l3_bw(L0Context &context);
+  void ze_peak_local_bw(L0Context &context);
+  void ze_peak_roofline();
 #ifndef EXCLUDE_MAIN
   void ze_peak_dp_compute(L0Context &context);
   void ze_peak_int_compute(L0Context &context);
@@ -0,0 +1,32 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#define SLM_ITEMS        1024
+#define SLM_READS_PER_WI 64
+
+// Every work item fills its share of a shared local memory tile from A,
+// then reads SLM_READS_PER_WI consecutive float4 of the tile, neighbouring
+// work items reading neighbouring elements. The tile is the same for every
+// group, so the global fetches that fill it hit in the cache.
+__kernel void local_bandwidth_v4(__global float4 *A, __global float *B)
+{
+    __local float4 tile[SLM_ITEMS];
+    uint lid = get_local_id(0);
+
+    for (uint i = lid; i < SLM_ITEMS; i += get_local_size(0)) {
+        tile[i] = A[i];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    float4 sum = 0;
+    for (uint i = 0; i < SLM_READS_PER_WI; i++) {
+        sum += tile[(lid + i) & (SLM_ITEMS - 1)];
+    }
+
+    B[get_global_id(0)] = (sum.S0) + (sum.S1) + (sum.S2) + (sum.S3);
+}
@@ -241,6 +241,7 @@ std::vector<long double> ZePeak::ze_peak_dp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp64", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -264,6 +265,7 @@ std::vector<long double> ZePeak::ze_peak_dp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp64", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -287,6 +289,7 @@ std::vector<long double> ZePeak::ze_peak_dp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp64", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -310,6 +313,7 @@ std::vector<long double> ZePeak::ze_peak_dp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp64", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -333,6 +337,7 @@ std::vector<long double> ZePeak::ze_peak_dp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp64", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
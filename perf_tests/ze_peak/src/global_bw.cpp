@@ -304,6 +304,7 @@ void ZePeak::ze_peak_global_bw(L0Context &context) {
 
     std::cout << gbps << " GB/s\n";
   }
+  record_bandwidth_ceiling(gbps);
 
   timed = 0;
   timed_lo = 0;
@@ -341,6 +342,7 @@ void ZePeak::ze_peak_global_bw(L0Context &context) {
 
     std::cout << gbps << " GB/s\n";
   }
+  record_bandwidth_ceiling(gbps);
 
   timed = 0;
   timed_lo = 0;
@@ -379,6 +381,7 @@ void ZePeak::ze_peak_global_bw(L0Context &context) {
 
     std::cout << gbps << " GB/s\n";
   }
+  record_bandwidth_ceiling(gbps);
 
   timed = 0;
   timed_lo = 0;
@@ -416,6 +419,7 @@ void ZePeak::ze_peak_global_bw(L0Context &context) {
 
     std::cout << gbps << " GB/s\n";
   }
+  record_bandwidth_ceiling(gbps);
 
   timed = 0;
   timed_lo = 0;
@@ -452,6 +456,7 @@ void ZePeak::ze_peak_global_bw(L0Context &context) {
 
     std::cout << gbps << " GB/s\n";
   }
+  record_bandwidth_ceiling(gbps);
 
   if (context.sub_device_count) {
     for (auto kernel : lo_offset_v1) {
@@ -148,6 +148,7 @@ void ZePeak::ze_peak_hp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp16", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -168,6 +169,7 @@ void ZePeak::ze_peak_hp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp16", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -189,6 +191,7 @@ void ZePeak::ze_peak_hp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp16", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -210,6 +213,7 @@ void ZePeak::ze_peak_hp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp16", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -231,6 +235,7 @@ void ZePeak::ze_peak_hp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp16", gflops);
 
   if (context.sub_device_count) {
     for (auto kernel : hp_v1) {
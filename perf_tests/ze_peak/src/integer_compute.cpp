@@ -227,6 +227,7 @@ std::vector<long double> ZePeak::ze_peak_int_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("int32", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -250,6 +251,7 @@ std::vector<long double> ZePeak::ze_peak_int_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("int32", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -273,6 +275,7 @@ std::vector<long double> ZePeak::ze_peak_int_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("int32", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -296,6 +299,7 @@ std::vector<long double> ZePeak::ze_peak_int_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("int32", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
@@ -319,6 +323,7 @@ std::vector<long double> ZePeak::ze_peak_int_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("int32", gflops);
 #ifdef EXCLUDE_MAIN
   gflops_list.push_back(gflops);
 #endif
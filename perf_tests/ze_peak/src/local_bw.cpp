@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../include/ze_peak.h"
+#include "../../common/include/common.hpp"
+
+#define SLM_ITEMS 1024
+#define SLM_READS_PER_WI 64
+
+//---------------------------------------------------------------------
+// Shared local memory bandwidth. Every work item reads SLM_READS_PER_WI
+// float4 from a tile in shared local memory, the fetches that fill the
+// tile are not counted. The kernel is short, so it is timed with events.
+//---------------------------------------------------------------------
+void ZePeak::ze_peak_local_bw(L0Context &context) {
+  long double timed = 0, gbps;
+  ze_result_t result = ZE_RESULT_SUCCESS;
+  struct ZeWorkGroups workgroup_info;
+  const size_t tile_size = SLM_ITEMS * 4 * sizeof(float);
+
+  if (context.device_compute_property.maxSharedLocalMemory < tile_size) {
+    std::cout << "SLM bandwidth test skipping: "
+              << context.device_compute_property.maxSharedLocalMemory
+              << " bytes of shared local memory, " << tile_size
+              << " needed\n";
+    return;
+  }
+
+  std::vector<uint8_t> binary_file =
+      context.load_binary_file("ze_local_bw.spv");
+
+  context.create_module(binary_file);
+
+  uint64_t numItems =
+      set_workgroups(context, get_max_work_items(context) * 16,
+                     &workgroup_info);
+
+  std::vector<float> arr(SLM_ITEMS * 4);
+  for (uint32_t i = 0; i < arr.size(); i++) {
+    arr[i] = static_cast<float>(i);
+  }
+
+  ze_device_mem_alloc_desc_t device_desc = {};
+  device_desc.stype = ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC;
+  device_desc.ordinal = 0;
+  device_desc.flags = 0;
+
+  std::vector<ze_device_handle_t> devices = context.sub_devices;
+  if (!context.sub_device_count) {
+    devices = {context.device};
+  }
+  std::vector<void *> input_bufs(devices.size());
+  std::vector<void *> output_bufs(devices.size());
+  std::vector<ze_kernel_handle_t> kernels(devices.size());
+  for (uint32_t i = 0; i < devices.size(); i++) {
+    result = zeMemAllocDevice(context.context, &device_desc, tile_size, 16,
+                              devices[i], &input_bufs[i]);
+    if (result) {
+      throw std::runtime_error("zeMemAllocDevice failed: " +
+                               std::to_string(result));
+    }
+    result = zeMemAllocDevice(context.context, &device_desc,
+                              static_cast<size_t>(numItems * sizeof(float)),
+                              1, devices[i], &output_bufs[i]);
+    if (result) {
+      throw std::runtime_error("zeMemAllocDevice failed: " +
+                               std::to_string(result));
+    }
+
+    ze_command_list_handle_t command_list = context.sub_device_count
+                                                ? context.cmd_list[i]
+                                                : context.command_list;
+    result = zeCommandListAppendMemoryCopy(command_list, input_bufs[i],
+                                           arr.data(), tile_size, nullptr, 0,
+                                           nullptr);
+    if (result) {
+      throw std::runtime_error("zeCommandListAppendMemoryCopy failed: " +
+                               std::to_string(result));
+    }
+    result = zeCommandListAppendBarrier(command_list, nullptr, 0, nullptr);
+    if (result) {
+      throw std::runtime_error("zeCommandListAppendBarrier failed: " +
+                               std::to_string(result));
+    }
+  }
+  if (verbose)
+    std::cout << "Input buffer copy encoded\n";
+
+  context.execute_commandlist_and_sync();
+
+  ze_kernel_desc_t kernel_desc = {ZE_STRUCTURE_TYPE_KERNEL_DESC, nullptr, 0,
+                                  "local_bandwidth_v4"};
+  for (uint32_t i = 0; i < devices.size(); i++) {
+    ze_module_handle_t module = context.sub_device_count
+                                    ? context.subdevice_module[i]
+                                    : context.module;
+    result = zeKernelCreate(module, &kernel_desc, &kernels[i]);
+    if (result) {
+      throw std::runtime_error("zeKernelCreate failed: " +
+                               std::to_string(result));
+    }
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernels[i], 0, sizeof(input_bufs[i]), &input_bufs[i]));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernels[i], 1, sizeof(output_bufs[i]), &output_bufs[i]));
+  }
+  if (verbose)
+    std::cout << "Functions created\n";
+
+  std::cout << "Shared local memory bandwidth (GB/s)\n";
+  std::cout << "float4 : ";
+  for (uint32_t i = 0; i < devices.size(); i++) {
+    current_sub_device_id = i;
+    timed += run_kernel(context, kernels[i], workgroup_info,
+                        TimingMeasurement::BANDWIDTH_EVENT_TIMING);
+  }
+  current_sub_device_id = 0;
+  gbps = calculate_gbps(timed, numItems * devices.size() * SLM_READS_PER_WI *
+                                   4 * sizeof(float));
+  std::cout << gbps << " GB/s\n";
+  std::string level = roofline_level;
+  roofline_level = "SLM";
+  record_bandwidth_ceiling(gbps);
+  roofline_level = level;
+
+  for (uint32_t i = 0; i < devices.size(); i++) {
+    result = zeKernelDestroy(kernels[i]);
+    if (result) {
+      throw std::runtime_error("zeKernelDestroy failed: " +
+                               std::to_string(result));
+    }
+    result = zeMemFree(context.context, input_bufs[i]);
+    if (result) {
+      throw std::runtime_error("zeMemFree failed: " + std::to_string(result));
+    }
+    result = zeMemFree(context.context, output_bufs[i]);
+    if (result) {
+      throw std::runtime_error("zeMemFree failed: " + std::to_string(result));
+    }
+  }
+  if (verbose)
+    std::cout << "Kernels destroyed and buffers freed\n";
+
+  if (context.sub_device_count) {
+    for (auto module : context.subdevice_module) {
+      result = zeModuleDestroy(module);
+      if (result) {
+        throw std::runtime_error("zeModuleDestroy failed: " +
+                                 std::to_string(result));
+      }
+    }
+  } else {
+    result = zeModuleDestroy(context.module);
+    if (result) {
+      throw std::runtime_error("zeModuleDestroy failed: " +
+                               std::to_string(result));
+    }
+  }
+  if (verbose)
+    std::cout << "Module destroyed\n";
+
+  print_test_complete();
+}
@@ -28,6 +28,10 @@ static const char *usage_str =
     "\n      int_compute             selectively run integer compute test"
     "\n      transfer_bw             selectively run transfer bandwidth test"
     "\n      kernel_lat              selectively run kernel latency test"
+    "\n      roofline                run the compute and bandwidth tests, L3 "
+    "and SLM"
+    "\n                              bandwidth included, and build the device "
+    "roofline"
     "\n  -a                          run all above tests [default]"
     "\n  -v                          enable verbose prints"
     "\n  -i                          set number of iterations to run[default: "
@@ -39,6 +43,13 @@ static const char *usage_str =
     "\n  -q                          query for number of engines available"
     "\n  -g, group                   select engine group (default: 0)"
     "\n  -n, number                  select engine index (default: 0)"
+    "\n  --roofline-kernels file     place the kernels of file on the "
+    "roofline,"
+    "\n                              one per line as "
+    "name,flops,bytes,usec[,precision]"
+    "\n  --roofline-output prefix    write the roofline to prefix.csv and "
+    "prefix.svg"
+    "\n                              [default: ze_peak_roofline]"
     "\n  -h, --help                  display help message"
     "\n";
 
@@ -89,10 +100,13 @@ int ZePeak::parse_arguments(int argc, char **argv) {
         run_transfer_bw = true;
       } else if (strcmp(argv[i], "kernel_lat") == 0) {
         run_kernel_lat = true;
+      } else if (strcmp(argv[i], "roofline") == 0) {
+        run_roofline = run_global_bw = run_hp_compute = run_sp_compute =
+            run_dp_compute = run_int_compute = true;
       } else {
         if (run_global_bw || run_hp_compute || run_sp_compute ||
             run_dp_compute || run_int_compute || run_transfer_bw ||
-            run_kernel_lat) {
+            run_kernel_lat || run_roofline) {
           stage = 0;
         } else {
           std::cout << usage_str;
@@ -157,6 +171,16 @@ int ZePeak::parse_arguments(int argc, char **argv) {
           command_queue_index = to_u32(argv[i + 1]);
         }
         i++;
+      } else if (strcmp(argv[i], "--roofline-kernels") == 0) {
+        if ((i + 1) < argc) {
+          roofline_kernels_file = argv[i + 1];
+          i++;
+        }
+      } else if (strcmp(argv[i], "--roofline-output") == 0) {
+        if ((i + 1) < argc) {
+          roofline_output = argv[i + 1];
+          i++;
+        }
       } else {
         std::cout << usage_str;
         exit(-1);
@@ -0,0 +1,526 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "../include/ze_peak.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+static const int plot_width = 64;
+static const int plot_height = 20;
+static const int svg_width = 800;
+static const int svg_height = 500;
+static const int svg_margin = 60;
+
+struct RooflineAxes {
+  long double x_min; /* FLOP/byte */
+  long double x_max;
+  long double y_min; /* GFLOPS */
+  long double y_max;
+};
+
+static void keep_best(std::vector<RooflineCeiling> &ceilings,
+                      const std::string &name, long double value) {
+  for (auto &ceiling : ceilings) {
+    if (ceiling.name == name) {
+      ceiling.value = std::max(ceiling.value, value);
+      return;
+    }
+  }
+  ceilings.push_back({name, value});
+}
+
+//---------------------------------------------------------------------
+// Every vector width of a test reports its result, the best one of each
+// precision and memory level is the ceiling.
+//---------------------------------------------------------------------
+void ZePeak::record_compute_ceiling(const std::string &precision,
+                                    long double gflops) {
+  keep_best(compute_ceilings, precision, gflops);
+}
+
+void ZePeak::record_bandwidth_ceiling(long double gbps) {
+  keep_best(bandwidth_ceilings, roofline_level, gbps);
+}
+
+//---------------------------------------------------------------------
+// The global bandwidth kernels are run again on a buffer of half the
+// largest device cache, so that after the warmup iterations every fetch
+// hits in the cache. Kernels this short are dominated by submission
+// overhead, so they are timed with events.
+//---------------------------------------------------------------------
+void ZePeak::ze_peak_l3_bw(L0Context &context) {
+  uint32_t count = 0;
+  ze_result_t result =
+      zeDeviceGetCacheProperties(context.device, &count, nullptr);
+  if (result) {
+    throw std::runtime_error("zeDeviceGetCacheProperties failed: " +
+                             std::to_string(result));
+  }
+  std::vector<ze_device_cache_properties_t> caches(
+      count, {ZE_STRUCTURE_TYPE_DEVICE_CACHE_PROPERTIES, nullptr});
+  result = zeDeviceGetCacheProperties(context.device, &count, caches.data());
+  if (result) {
+    throw std::runtime_error("zeDeviceGetCacheProperties failed: " +
+                             std::to_string(result));
+  }
+  size_t cache_size = 0;
+  for (auto &cache : caches) {
+    cache_size = std::max(cache_size, cache.cacheSize);
+  }
+
+  uint64_t items = cache_size / 2 / sizeof(float);
+  uint64_t min_items =
+      context.device_compute_property.maxGroupSizeX * FETCH_PER_WI * 16;
+  if (items < min_items) {
+    std::cout << "L3 bandwidth test skipping: cache size of " << cache_size
+              << " bytes too small for the bandwidth kernels\n";
+    return;
+  }
+
+  std::cout << "L3 cache bandwidth, " << items * sizeof(float)
+            << " byte buffer\n";
+  uint32_t max_size = global_bw_max_size;
+  bool event_timer = use_event_timer;
+  global_bw_max_size = static_cast<uint32_t>(items);
+  use_event_timer = true;
+  roofline_level = "L3";
+  ze_peak_global_bw(context);
+  global_bw_max_size = max_size;
+  use_event_timer = event_timer;
+  roofline_level = "global";
+}
+
+//---------------------------------------------------------------------
+// Reads the kernels to place on the roofline, one per line as
+// name,flops,bytes,usec[,precision]. Empty lines and lines starting with #
+// are skipped.
+//---------------------------------------------------------------------
+static std::vector<RooflineKernel>
+read_roofline_kernels(const std::string &file_path) {
+  std::vector<RooflineKernel> kernels;
+  std::ifstream stream(file_path);
+  if (!stream.good()) {
+    throw std::runtime_error("Failed to open roofline kernels file: " +
+                             file_path);
+  }
+
+  std::string line;
+  for (int line_number = 1; std::getline(stream, line); line_number++) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::stringstream fields(line);
+    RooflineKernel kernel;
+    std::string flops, bytes, usec;
+    std::getline(fields, kernel.name, ',');
+    std::getline(fields, flops, ',');
+    std::getline(fields, bytes, ',');
+    std::getline(fields, usec, ',');
+    std::getline(fields, kernel.precision, ',');
+    try {
+      kernel.flops = std::stold(flops);
+      kernel.bytes = std::stold(bytes);
+      kernel.usec = std::stold(usec);
+    } catch (const std::exception &) {
+      kernel.flops = kernel.bytes = kernel.usec = 0;
+    }
+    if (kernel.name.empty() || !(kernel.flops > 0) || !(kernel.bytes > 0) ||
+        !(kernel.usec > 0) || !std::isfinite(kernel.flops) ||
+        !std::isfinite(kernel.bytes) || !std::isfinite(kernel.usec)) {
+      throw std::runtime_error(file_path + ":" + std::to_string(line_number) +
+                               ": expected name,flops,bytes,usec");
+    }
+    kernels.push_back(kernel);
+  }
+  return kernels;
+}
+
+static long double intensity(const RooflineKernel &kernel) {
+  return kernel.flops / kernel.bytes;
+}
+
+static long double gflops(const RooflineKernel &kernel) {
+  return kernel.flops / kernel.usec / 1000;
+}
+
+/* Position of value between low and high on a log scale, from 0 to 1 */
+static long double log_fraction(long double value, long double low,
+                                long double high) {
+  return (std::log10(value) - std::log10(low)) /
+         (std::log10(high) - std::log10(low));
+}
+
+static long double decade_below(long double value) {
+  return std::pow(10.0L, std::floor(std::log10(value)));
+}
+
+static long double decade_above(long double value) {
+  return std::pow(10.0L, std::ceil(std::log10(value)));
+}
+
+static std::string kernel_label(size_t index) {
+  return std::string(1, static_cast<char>('A' + index % 26));
+}
+
+// Kernel names come from the user's file and may contain characters which
+// are markup in the SVG image.
+static std::string xml_escape(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    switch (c) {
+    case '&':
+      escaped += "&amp;";
+      break;
+    case '<':
+      escaped += "&lt;";
+      break;
+    case '>':
+      escaped += "&gt;";
+      break;
+    case '"':
+      escaped += "&quot;";
+      break;
+    default:
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+//---------------------------------------------------------------------
+// Axes in whole decades, spanning the ridge points of every ceiling and
+// every kernel.
+//---------------------------------------------------------------------
+static RooflineAxes roofline_axes(const std::vector<RooflineCeiling> &compute,
+                                  const std::vector<RooflineCeiling> &memory,
+                                  const std::vector<RooflineKernel> &kernels) {
+  long double peak = 0, lowest_compute = compute[0].value;
+  long double fastest = 0, slowest = memory[0].value;
+  for (auto &ceiling : compute) {
+    peak = std::max(peak, ceiling.value);
+    lowest_compute = std::min(lowest_compute, ceiling.value);
+  }
+  for (auto &ceiling : memory) {
+    fastest = std::max(fastest, ceiling.value);
+    slowest = std::min(slowest, ceiling.value);
+  }
+
+  RooflineAxes axes;
+  axes.x_min = std::min(0.1L, lowest_compute / fastest / 10);
+  axes.x_max = peak / slowest * 10;
+  axes.y_min = std::min(lowest_compute, slowest * axes.x_min);
+  axes.y_max = peak * 2;
+  for (auto &kernel : kernels) {
+    axes.x_min = std::min(axes.x_min, intensity(kernel));
+    axes.x_max = std::max(axes.x_max, intensity(kernel));
+    axes.y_min = std::min(axes.y_min, gflops(kernel));
+    axes.y_max = std::max(axes.y_max, gflops(kernel));
+  }
+  axes.x_min = decade_below(axes.x_min);
+  axes.x_max = decade_above(axes.x_max * 1.01L);
+  axes.y_min = decade_below(axes.y_min);
+  axes.y_max = decade_above(axes.y_max * 1.01L);
+  return axes;
+}
+
+//---------------------------------------------------------------------
+// Prints the roofline as text. Memory ceilings are drawn with the first
+// letter of their level in lower case, compute ceilings with '-' and
+// labelled on the right, kernels with their letter.
+//---------------------------------------------------------------------
+static void print_roofline_plot(const std::vector<RooflineCeiling> &compute,
+                                const std::vector<RooflineCeiling> &memory,
+                                const std::vector<RooflineKernel> &kernels,
+                                const RooflineAxes &axes) {
+  std::vector<std::string> grid(plot_height, std::string(plot_width, ' '));
+  std::vector<std::string> labels(plot_height);
+  long double peak = 0, fastest = 0;
+  for (auto &ceiling : compute) {
+    peak = std::max(peak, ceiling.value);
+  }
+  for (auto &ceiling : memory) {
+    fastest = std::max(fastest, ceiling.value);
+  }
+
+  auto row = [&](long double y) {
+    long double f = log_fraction(y, axes.y_min, axes.y_max);
+    int r = static_cast<int>((1 - f) * plot_height);
+    return std::clamp(r, 0, plot_height - 1);
+  };
+  auto column = [&](long double x) {
+    long double f = log_fraction(x, axes.x_min, axes.x_max);
+    return std::clamp(static_cast<int>(f * plot_width), 0, plot_width - 1);
+  };
+
+  for (int c = 0; c < plot_width; c++) {
+    long double x = std::pow(
+        10.0L, std::log10(axes.x_min) +
+                   (c + 0.5L) / plot_width *
+                       (std::log10(axes.x_max) - std::log10(axes.x_min)));
+    for (auto &ceiling : memory) {
+      long double y = ceiling.value * x;
+      if (y <= peak && y >= axes.y_min) {
+        grid[static_cast<size_t>(row(y))][static_cast<size_t>(c)] =
+            static_cast<char>(std::tolower(ceiling.name[0]));
+      }
+    }
+    for (auto &ceiling : compute) {
+      if (fastest * x >= ceiling.value) {
+        grid[static_cast<size_t>(row(ceiling.value))][static_cast<size_t>(c)] =
+            '-';
+      }
+    }
+  }
+  for (auto &ceiling : compute) {
+    std::string &label = labels[static_cast<size_t>(row(ceiling.value))];
+    label += (label.empty() ? " " : ",") + ceiling.name;
+  }
+  for (size_t i = 0; i < kernels.size(); i++) {
+    grid[static_cast<size_t>(row(gflops(kernels[i])))]
+        [static_cast<size_t>(column(intensity(kernels[i])))] =
+            kernel_label(i)[0];
+  }
+
+  std::cout << "GFLOPS\n";
+  for (int r = 0; r < plot_height; r++) {
+    std::string axis_label;
+    for (long double y = axes.y_min; y <= axes.y_max * 1.01L; y *= 10) {
+      if (row(y) == r) {
+        std::stringstream value;
+        value << static_cast<double>(y);
+        axis_label = value.str();
+      }
+    }
+    std::cout << std::setw(10) << axis_label << " |"
+              << grid[static_cast<size_t>(r)]
+              << labels[static_cast<size_t>(r)] << "\n";
+  }
+  std::cout << std::setw(10) << "" << " +" << std::string(plot_width, '-')
+            << "\n";
+
+  std::string x_labels(plot_width + 8, ' ');
+  for (long double x = axes.x_min; x <= axes.x_max * 1.01L; x *= 10) {
+    std::stringstream value;
+    value << static_cast<double>(x);
+    size_t position = static_cast<size_t>(
+        log_fraction(x, axes.x_min, axes.x_max) * plot_width);
+    x_labels.replace(position, value.str().size(), value.str());
+  }
+  x_labels.erase(x_labels.find_last_not_of(' ') + 1);
+  std::cout << std::setw(12) << "" << x_labels << "\n";
+  std::cout << std::setw(12) << "" << "FLOP/byte\n";
+}
+
+//---------------------------------------------------------------------
+// Writes the roofline as an SVG image with log scaled axes.
+//---------------------------------------------------------------------
+static void write_roofline_svg(const std::string &file_path,
+                               const std::vector<RooflineCeiling> &compute,
+                               const std::vector<RooflineCeiling> &memory,
+                               const std::vector<RooflineKernel> &kernels,
+                               const RooflineAxes &axes) {
+  std::ofstream svg(file_path);
+  if (!svg.good()) {
+    throw std::runtime_error("Failed to open roofline image: " + file_path);
+  }
+  const long double plot_w = svg_width - 2 * svg_margin;
+  const long double plot_h = svg_height - 2 * svg_margin;
+  auto sx = [&](long double x) {
+    return static_cast<double>(svg_margin + plot_w * log_fraction(
+                                                         x, axes.x_min,
+                                                         axes.x_max));
+  };
+  auto sy = [&](long double y) {
+    return static_cast<double>(svg_height - svg_margin -
+                               plot_h *
+                                   log_fraction(y, axes.y_min, axes.y_max));
+  };
+  long double peak = 0, fastest = 0;
+  for (auto &ceiling : compute) {
+    peak = std::max(peak, ceiling.value);
+  }
+  for (auto &ceiling : memory) {
+    fastest = std::max(fastest, ceiling.value);
+  }
+
+  svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << svg_width
+      << "\" height=\"" << svg_height << "\" font-family=\"sans-serif\" "
+      << "font-size=\"12\">\n";
+  svg << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+  for (long double x = axes.x_min; x <= axes.x_max * 1.01L; x *= 10) {
+    svg << "<line x1=\"" << sx(x) << "\" y1=\"" << svg_margin << "\" x2=\""
+        << sx(x) << "\" y2=\"" << svg_height - svg_margin
+        << "\" stroke=\"#ddd\"/>\n";
+    svg << "<text x=\"" << sx(x) << "\" y=\"" << svg_height - svg_margin + 16
+        << "\" text-anchor=\"middle\">" << static_cast<double>(x)
+        << "</text>\n";
+  }
+  for (long double y = axes.y_min; y <= axes.y_max * 1.01L; y *= 10) {
+    svg << "<line x1=\"" << svg_margin << "\" y1=\"" << sy(y) << "\" x2=\""
+        << svg_width - svg_margin << "\" y2=\"" << sy(y)
+        << "\" stroke=\"#ddd\"/>\n";
+    svg << "<text x=\"" << svg_margin - 4 << "\" y=\"" << sy(y) + 4
+        << "\" text-anchor=\"end\">" << static_cast<double>(y)
+        << "</text>\n";
+  }
+  svg << "<text x=\"" << svg_width / 2 << "\" y=\"" << svg_height - 16
+      << "\" text-anchor=\"middle\">Arithmetic intensity (FLOP/byte)"
+      << "</text>\n";
+  svg << "<text x=\"16\" y=\"" << svg_height / 2
+      << "\" text-anchor=\"middle\" transform=\"rotate(-90 16 "
+      << svg_height / 2 << ")\">Performance (GFLOPS)</text>\n";
+
+  for (auto &ceiling : memory) {
+    long double x_start = std::max(axes.x_min, axes.y_min / ceiling.value);
+    long double x_end = std::min(axes.x_max, peak / ceiling.value);
+    svg << "<line x1=\"" << sx(x_start) << "\" y1=\""
+        << sy(ceiling.value * x_start) << "\" x2=\"" << sx(x_end)
+        << "\" y2=\"" << sy(ceiling.value * x_end)
+        << "\" stroke=\"steelblue\" stroke-width=\"2\"/>\n";
+    svg << "<text x=\"" << sx(x_start) + 4 << "\" y=\""
+        << sy(ceiling.value * x_start) - 6 << "\" fill=\"steelblue\">"
+        << ceiling.name << " " << std::fixed << std::setprecision(1)
+        << static_cast<double>(ceiling.value) << " GB/s</text>\n";
+    svg << std::defaultfloat << std::setprecision(6);
+  }
+  for (auto &ceiling : compute) {
+    long double x_start = ceiling.value / fastest;
+    svg << "<line x1=\"" << sx(x_start) << "\" y1=\"" << sy(ceiling.value)
+        << "\" x2=\"" << svg_width - svg_margin << "\" y2=\""
+        << sy(ceiling.value)
+        << "\" stroke=\"firebrick\" stroke-width=\"2\"/>\n";
+    svg << "<text x=\"" << svg_width - svg_margin - 4 << "\" y=\""
+        << sy(ceiling.value) - 6
+        << "\" text-anchor=\"end\" fill=\"firebrick\">" << ceiling.name << " "
+        << std::fixed << std::setprecision(1)
+        << static_cast<double>(ceiling.value) << " GFLOPS</text>\n";
+    svg << std::defaultfloat << std::setprecision(6);
+  }
+  for (size_t i = 0; i < kernels.size(); i++) {
+    svg << "<circle cx=\"" << sx(intensity(kernels[i])) << "\" cy=\""
+        << sy(gflops(kernels[i])) << "\" r=\"4\"/>\n";
+    svg << "<text x=\"" << sx(intensity(kernels[i])) + 6 << "\" y=\""
+        << sy(gflops(kernels[i])) + 4 << "\">" << kernel_label(i) << " "
+        << xml_escape(kernels[i].name) << "</text>\n";
+  }
+  svg << "</svg>\n";
+}
+
+//---------------------------------------------------------------------
+// Ceilings of tests which did not run or are not supported are zero, they
+// cannot be drawn on log scaled axes and are left out with a warning.
+//---------------------------------------------------------------------
+static std::vector<RooflineCeiling>
+drawable_ceilings(const std::vector<RooflineCeiling> &ceilings,
+                  const std::string &unit) {
+  std::vector<RooflineCeiling> drawable;
+  for (auto &ceiling : ceilings) {
+    if (ceiling.value > 0 && std::isfinite(ceiling.value)) {
+      drawable.push_back(ceiling);
+    } else {
+      std::cout << "WARNING: " << ceiling.name << " ceiling of "
+                << static_cast<double>(ceiling.value) << " " << unit
+                << " left out of the roofline\n";
+    }
+  }
+  return drawable;
+}
+
+//---------------------------------------------------------------------
+// Builds the device roofline from the ceilings recorded by the compute
+// and bandwidth tests and places the kernels of the roofline kernels file
+// on it. The attainable performance of a kernel is bounded by the compute
+// ceiling of its precision, or the highest one if it has none or names no
+// measured ceiling, and the global memory ceiling. Writes the ceilings and
+// kernels to <roofline_output>.csv, the plot to <roofline_output>.svg and
+// prints the plot as text.
+//---------------------------------------------------------------------
+void ZePeak::ze_peak_roofline() {
+  std::vector<RooflineCeiling> compute =
+      drawable_ceilings(compute_ceilings, "GFLOPS");
+  std::vector<RooflineCeiling> bandwidth =
+      drawable_ceilings(bandwidth_ceilings, "GB/s");
+  if (compute.empty() || bandwidth.empty()) {
+    std::cout << "roofline skipping: no compute or bandwidth results\n";
+    return;
+  }
+  std::vector<RooflineKernel> kernels;
+  if (!roofline_kernels_file.empty()) {
+    kernels = read_roofline_kernels(roofline_kernels_file);
+  }
+
+  long double peak = 0;
+  for (auto &ceiling : compute) {
+    peak = std::max(peak, ceiling.value);
+  }
+  long double memory = bandwidth[0].value;
+  for (auto &ceiling : bandwidth) {
+    if (ceiling.name == "global") {
+      memory = ceiling.value;
+    }
+  }
+
+  std::ofstream csv(roofline_output + ".csv");
+  if (!csv.good()) {
+    throw std::runtime_error("Failed to open roofline data file: " +
+                             roofline_output + ".csv");
+  }
+  csv << "type,name,GFLOPS,GB/s,FLOP/byte,attainable GFLOPS\n";
+
+  std::cout << "Roofline\n";
+  std::cout << std::fixed << std::setprecision(2);
+  for (auto &ceiling : compute) {
+    std::cout << ceiling.name << " : " << ceiling.value
+              << " GFLOPS, ridge at " << ceiling.value / memory
+              << " FLOP/byte\n";
+    csv << "compute," << ceiling.name << "," << ceiling.value << ",,"
+        << ceiling.value / memory << ",\n";
+  }
+  for (auto &ceiling : bandwidth) {
+    std::cout << ceiling.name << " : " << ceiling.value << " GB/s\n";
+    csv << "bandwidth," << ceiling.name << ",," << ceiling.value << ",,\n";
+  }
+  for (size_t i = 0; i < kernels.size(); i++) {
+    long double kernel_peak = peak;
+    bool matched = kernels[i].precision.empty();
+    for (auto &ceiling : compute) {
+      if (ceiling.name == kernels[i].precision) {
+        kernel_peak = ceiling.value;
+        matched = true;
+      }
+    }
+    if (!matched) {
+      std::cout << "WARNING: precision " << kernels[i].precision << " of "
+                << kernels[i].name
+                << " matches no compute ceiling, bound by the highest one\n";
+    }
+    long double roof = std::min(kernel_peak, intensity(kernels[i]) * memory);
+    std::cout << kernel_label(i) << " " << kernels[i].name << " : "
+              << intensity(kernels[i]) << " FLOP/byte, "
+              << gflops(kernels[i]) << " GFLOPS, "
+              << gflops(kernels[i]) * 100 / roof << " % of " << roof
+              << " GFLOPS attainable ("
+              << (intensity(kernels[i]) * memory < kernel_peak ? "memory"
+                                                               : "compute")
+              << " bound)\n";
+    csv << "kernel," << kernels[i].name << "," << gflops(kernels[i])
+        << ",," << intensity(kernels[i]) << "," << roof << "\n";
+  }
+  std::cout << std::defaultfloat << std::setprecision(6);
+
+  RooflineAxes axes = roofline_axes(compute, bandwidth, kernels);
+  print_roofline_plot(compute, bandwidth, kernels, axes);
+  write_roofline_svg(roofline_output + ".svg", compute, bandwidth, kernels,
+                     axes);
+  std::cout << "Roofline written to " << roofline_output << ".csv and "
+            << roofline_output << ".svg\n";
+  print_test_complete();
+}
@@ -222,6 +222,7 @@ void ZePeak::ze_peak_sp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp32", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -242,6 +243,7 @@ void ZePeak::ze_peak_sp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp32", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -262,6 +264,7 @@ void ZePeak::ze_peak_sp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp32", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -282,6 +285,7 @@ void ZePeak::ze_peak_sp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp32", gflops);
 
   timed = 0;
   ///////////////////////////////////////////////////////////////////////////
@@ -302,6 +306,7 @@ void ZePeak::ze_peak_sp_compute(L0Context &context) {
     gflops = calculate_gbps(timed, number_of_work_items * flops_per_work_item);
     std::cout << gflops << " GFLOPS\n";
   }
+  record_compute_ceiling("fp32", gflops);
 
   if (context.sub_device_count) {
     for (auto kernel : sp_v1) {
@@ -1782,6 +1782,11 @@ int main(int argc, char **argv) {
   if (peak_benchmark.run_global_bw)
     peak_benchmark.ze_peak_global_bw(context);
 
+  if (peak_benchmark.run_roofline) {
+    peak_benchmark.ze_peak_l3_bw(context);
+    peak_benchmark.ze_peak_local_bw(context);
+  }
+
   if (peak_benchmark.run_hp_compute)
     peak_benchmark.ze_peak_hp_compute(context);
 
@@ -1800,6 +1805,9 @@ int main(int argc, char **argv) {
   if (peak_benchmark.run_kernel_lat)
     peak_benchmark.ze_peak_kernel_latency(context);
 
+  if (peak_benchmark.run_roofline)
+    peak_benchmark.ze_peak_roofline();
+
   context.clean_xe();
 
   std::cout << std::flush;
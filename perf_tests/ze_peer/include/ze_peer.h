@@ -22,11 +22,13 @@
 #include <utility>
 #include "common.hpp"
 #include "ze_app.hpp"
+#include "ze_checksum.hpp"
 #include <unistd.h>
 #include <iostream>
 #include <cstdlib>
 #include <signal.h>
 #include <level_zero/ze_api.h>
+#include <level_zero/zes_api.h>
 
 typedef enum _peer_transfer_t {
   PEER_WRITE = 0,
@@ -44,6 +46,16 @@ typedef struct _ze_peer_device_t {
       engines;
 } ze_peer_device_t;
 
+typedef struct _fabric_port_t {
+  uint32_t device_id;
+  zes_fabric_port_handle_t handle;
+  std::string name;
+  std::string remote_name;
+  long double rx_speed; /* bytes per second, 0 if unknown */
+  long double tx_speed;
+  zes_fabric_port_throughput_t start;
+} fabric_port_t;
+
 static const char *usage_str =
     "\nze_peer: Level Zero microbenchmark to analyze the P2P performance\n"
     "of a multi-GPU system.\n"
@@ -62,8 +74,11 @@ static const char *usage_str =
     "\n  -i                          number of iterations to run. Default: 50."
     "\n  -z                          size to run in bytes. Default: 8192(8MB) "
     "to 268435456(256MB)."
-    "\n  -v                          validate data (only 1 iteration is "
-    "executed). Default: Not set."
+    "\n  -v                          validate data of every iteration, "
+    "checking time"
+    "\n                              excluded. Parallel tests validate the "
+    "final"
+    "\n                              buffer only. Default: Not set."
     "\n  -t                          type of transfer to measure"
     "\n      transfer_bw             run transfer bandwidth test"
     "\n      latency                 run latency test"
@@ -140,6 +155,13 @@ static const char *usage_str =
     "\n  --regular_cmdlist           use regular command list instead of "
     "immediate"
     "\n"
+    "\n  --fabric_counters           sample the throughput counters of the "
+    "fabric ports"
+    "\n                              during each transfer and report link "
+    "bytes and"
+    "\n                              utilization per port. Not available with "
+    "--ipc."
+    "\n"
     "\n  --version                   display version"
     "\n  -h, --help                  display help message"
     "\n";
@@ -290,6 +312,14 @@ public:
                                  char *validate_buffer, void *dst_buffer,
                                  char *host_buffer, size_t buffer_size);
 
+  bool checksum_matches(void *dst_buffer, char *host_buffer,
+                        size_t buffer_size);
+
+  long double verify_iteration(void *dst_buffer, size_t buffer_size,
+                               uint64_t expected_checksum);
+
+  void report_iteration_errors();
+
   void set_up(size_t number_buffer_elements,
               std::vector<uint32_t> &remote_device_ids,
               std::vector<uint32_t> &local_device_ids, size_t &buffer_size);
@@ -306,6 +336,10 @@ public:
 
   void query_engines();
 
+  void init_fabric_ports();
+  void start_fabric_counters();
+  void print_fabric_counters(bool bidirectional, size_t buffer_size);
+
   // IPC
   void bandwidth_latency_ipc(peer_test_t test_type,
                              peer_transfer_t transfer_type, bool is_server,
@@ -320,6 +354,8 @@ public:
   int recvmsg_fd(int socket);
 
   ZeApp *benchmark;
+  ZeChecksum *checksum = nullptr;
+  uint32_t iteration_errors = 0;
 
   std::vector<void *> ze_buffers;
   std::vector<void *> ze_ipc_buffers;
@@ -340,6 +376,8 @@ public:
   ze_event_pool_handle_t event_pool = {};
   ze_event_handle_t event = {};
 
+  std::vector<fabric_port_t> fabric_ports;
+
   static bool use_queue_in_destination;
   static bool run_continuously;
   static bool bidirectional;
@@ -349,6 +387,7 @@ public:
   static bool parallel_copy_to_pair_targets;
   static bool parallel_divide_buffers;
   static bool use_immediate_cmdlist;
+  static bool sample_fabric_counters;
 
   static uint32_t number_iterations;
   uint32_t warm_up_iterations = number_iterations / 5;
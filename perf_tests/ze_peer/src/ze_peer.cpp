@@ -19,6 +19,7 @@ bool ZePeer::parallel_copy_to_multiple_targets = false;
 bool ZePeer::parallel_copy_to_pair_targets = false;
 bool ZePeer::parallel_divide_buffers = false;
 bool ZePeer::use_immediate_cmdlist = true;
+bool ZePeer::sample_fabric_counters = false;
 uint32_t ZePeer::number_iterations = 50;
 const size_t max_elems = 268435456; /* 256 MB */
 
@@ -115,22 +116,12 @@ void run_ipc_test(int size_to_run, uint32_t remote_device_id,
       if (test_pid == 0) {
         ZePeer peer(remote_device_ids, local_device_ids, pair_device_ids,
                     queues);
-        if (ZePeer::validate_results) {
-          peer.warm_up_iterations = 0;
-          peer.number_iterations = 1;
-        }
-
         peer.bandwidth_latency_ipc(test_type, transfer_type,
                                    false /* is_server */, sv[1], num_elems,
                                    local_device_id, remote_device_id);
       } else {
         ZePeer peer(remote_device_ids, local_device_ids, pair_device_ids,
                     queues);
-        if (ZePeer::validate_results) {
-          peer.warm_up_iterations = 0;
-          peer.number_iterations = 1;
-        }
-
         peer.bandwidth_latency_ipc(test_type, transfer_type,
                                    true /* is_server */, sv[0], num_elems,
                                    remote_device_id, local_device_id);
@@ -167,11 +158,6 @@ void run_test(int size_to_run, std::vector<uint32_t> &remote_device_ids,
       num_elems = static_cast<size_t>(size_to_run);
     }
     ZePeer peer(remote_device_ids, local_device_ids, pair_device_ids, queues);
-    if (ZePeer::validate_results) {
-      peer.warm_up_iterations = 0;
-      peer.number_iterations = 1;
-    }
-
     if (peer.run_continuously) {
       struct sigaction sigIntHandler;
       sigIntHandler.sa_handler = stress_handler;
@@ -460,12 +446,25 @@ int main(int argc, char **argv) {
       ZePeer::validate_results = true;
     } else if (strcmp(argv[i], "--regular_cmdlist") == 0) {
       ZePeer::use_immediate_cmdlist = false;
+    } else if (strcmp(argv[i], "--fabric_counters") == 0) {
+      ZePeer::sample_fabric_counters = true;
     } else {
       std::cout << usage_str;
       exit(-1);
     }
   }
 
+  if (ZePeer::sample_fabric_counters && run_ipc) {
+    std::cerr << "[ERROR] Fabric counters with IPC tests not implemented\n";
+    ZePeer::sample_fabric_counters = false;
+  }
+  if (ZePeer::sample_fabric_counters) {
+    // Fabric ports are queried through the core device handles, which
+    // requires sysman to be enabled before the driver is initialized.
+    static char enable_sysman[] = "ZES_ENABLE_SYSMAN=1";
+    putenv(enable_sysman);
+  }
+
   if (run_ipc == false) {
     // Detect number of devices
     ZePeer peerQueryDevices(&num_devices);
@@ -755,6 +754,10 @@ ZePeer::ZePeer(std::vector<uint32_t> &remote_device_ids,
   ze_event_desc_t event_desc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
   event_desc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
   SUCCESS_OR_TERMINATE(zeEventCreate(event_pool, &event_desc, &event));
+
+  if (ZePeer::sample_fabric_counters) {
+    init_fabric_ports();
+  }
 }
 
 ZePeer::~ZePeer() {
@@ -770,6 +773,7 @@ ZePeer::~ZePeer() {
     SUCCESS_OR_TERMINATE(zeEventDestroy(event));
     SUCCESS_OR_TERMINATE(zeEventPoolDestroy(event_pool));
   }
+  delete checksum;
   benchmark->allDevicesCleanup();
   delete benchmark;
 }
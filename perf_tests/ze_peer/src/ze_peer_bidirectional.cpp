@@ -39,6 +39,8 @@ void ZePeer::bidirectional_perform_copy(
   SUCCESS_OR_TERMINATE(zeCommandListClose(remote_command_list));
 
   Timer<std::chrono::microseconds::period> timer;
+  uint64_t expected_checksum =
+      validate_results ? ZeChecksum::host(ze_host_buffer, buffer_size) : 0;
 
   /* Warm up */
   for (uint32_t i = 0U; i < warm_up_iterations; i++) {
@@ -55,6 +57,7 @@ void ZePeer::bidirectional_perform_copy(
   }
 
   do {
+    start_fabric_counters();
     long double time_usec = 0;
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
@@ -71,9 +74,17 @@ void ZePeer::bidirectional_perform_copy(
       timer.end();
       time_usec += timer.period_minus_overhead();
 
+      if (validate_results) {
+        verify_iteration(ze_dst_buffers[remote_device_id], buffer_size,
+                         expected_checksum);
+        verify_iteration(ze_dst_buffers[local_device_id], buffer_size,
+                         expected_checksum);
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
     }
     print_results(true, test_type, buffer_size, time_usec);
+    print_fabric_counters(true, buffer_size);
   } while (run_continuously);
 
   SUCCESS_OR_TERMINATE(zeCommandListReset(local_command_list));
@@ -89,6 +100,8 @@ void ZePeer::bidirectional_perform_copy_immediate(
       ze_peer_devices[remote_device_id].engines[queue_index].second;
 
   Timer<std::chrono::microseconds::period> timer;
+  uint64_t expected_checksum =
+      validate_results ? ZeChecksum::host(ze_host_buffer, buffer_size) : 0;
 
   /* Warm up */
   for (uint32_t i = 0U; i < warm_up_iterations; i++) {
@@ -116,6 +129,7 @@ void ZePeer::bidirectional_perform_copy_immediate(
   }
 
   do {
+    start_fabric_counters();
     long double time_usec = 0;
     for (uint32_t i = 0U; i < number_iterations; i++) {
       if (transfer_type == PEER_WRITE) {
@@ -143,9 +157,17 @@ void ZePeer::bidirectional_perform_copy_immediate(
       timer.end();
       time_usec += timer.period_minus_overhead();
 
+      if (validate_results) {
+        verify_iteration(ze_dst_buffers[remote_device_id], buffer_size,
+                         expected_checksum);
+        verify_iteration(ze_dst_buffers[local_device_id], buffer_size,
+                         expected_checksum);
+      }
+
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
     }
     print_results(true, test_type, buffer_size, time_usec);
+    print_fabric_counters(true, buffer_size);
   } while (run_continuously);
 }
 
@@ -177,6 +199,7 @@ void ZePeer::bidirectional_bandwidth_latency(peer_test_t test_type,
   }
 
   if (validate_results) {
+    report_iteration_errors();
     if (ZePeer::use_immediate_cmdlist) {
       validate_buffer_immediate(
           ze_peer_devices[remote_device_id].engines[0].second,
@@ -268,10 +268,50 @@ void ZePeer::initialize_buffers(std::vector<uint32_t> &remote_device_ids,
   }
 }
 
+// Compares the checksum of the destination, computed on the device which
+// holds it, with the checksum of the expected data, so the destination is
+// only read back to locate the first error when they differ.
+bool ZePeer::checksum_matches(void *dst_buffer, char *host_buffer,
+                              size_t buffer_size) {
+  if (checksum == nullptr) {
+    checksum = new ZeChecksum(benchmark);
+  }
+  return checksum->compute(dst_buffer, buffer_size) ==
+         ZeChecksum::host(host_buffer, buffer_size);
+}
+
+// Checksums the destination of a timed iteration and counts a mismatch in
+// iteration_errors. Returns the time taken, which the caller subtracts
+// from the measured time.
+long double ZePeer::verify_iteration(void *dst_buffer, size_t buffer_size,
+                                     uint64_t expected_checksum) {
+  Timer<std::chrono::microseconds::period> timer;
+  timer.start();
+  if (checksum == nullptr) {
+    checksum = new ZeChecksum(benchmark);
+  }
+  if (checksum->compute(dst_buffer, buffer_size) != expected_checksum) {
+    iteration_errors++;
+  }
+  timer.end();
+  return timer.period_minus_overhead();
+}
+
+void ZePeer::report_iteration_errors() {
+  if (iteration_errors) {
+    std::cout << "Validation failed in " << iteration_errors
+              << " timed iterations\n";
+  }
+  iteration_errors = 0;
+}
+
 void ZePeer::validate_buffer(ze_command_list_handle_t command_list,
                              ze_command_queue_handle_t command_queue,
                              char *validate_buffer, void *dst_buffer,
                              char *host_buffer, size_t buffer_size) {
+  if (checksum_matches(dst_buffer, host_buffer, buffer_size)) {
+    return;
+  }
   SUCCESS_OR_TERMINATE(
       zeCommandListAppendMemoryCopy(command_list, validate_buffer, dst_buffer,
                                     buffer_size, nullptr, 0, nullptr));
@@ -296,6 +336,9 @@ void ZePeer::validate_buffer(ze_command_list_handle_t command_list,
 void ZePeer::validate_buffer_immediate(ze_command_list_handle_t command_list,
                                        char *validate_buffer, void *dst_buffer,
                                        char *host_buffer, size_t buffer_size) {
+  if (checksum_matches(dst_buffer, host_buffer, buffer_size)) {
+    return;
+  }
   SUCCESS_OR_TERMINATE(
       zeCommandListAppendMemoryCopy(command_list, validate_buffer, dst_buffer,
                                     buffer_size, nullptr, 0, nullptr));
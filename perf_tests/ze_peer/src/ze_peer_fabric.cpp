@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_peer.h"
+
+static std::string port_name(const zes_fabric_port_id_t &port_id) {
+  return std::to_string(port_id.fabricId) + "." +
+         std::to_string(port_id.attachId) + "." +
+         std::to_string(static_cast<uint32_t>(port_id.portNumber));
+}
+
+/* Bytes per second of a link, or 0 if the driver does not report it */
+static long double link_speed(const zes_fabric_port_speed_t &speed,
+                              const zes_fabric_port_speed_t &max_speed) {
+  const zes_fabric_port_speed_t &known = speed.bitRate > 0 ? speed : max_speed;
+  if (known.bitRate <= 0 || known.width <= 0) {
+    return 0;
+  }
+  return static_cast<long double>(known.bitRate) * known.width / 8;
+}
+
+void ZePeer::init_fabric_ports() {
+  for (uint32_t d = 0; d < benchmark->_devices.size(); d++) {
+    zes_device_handle_t device =
+        reinterpret_cast<zes_device_handle_t>(benchmark->_devices[d]);
+    uint32_t count = 0;
+    ze_result_t result = zesDeviceEnumFabricPorts(device, &count, nullptr);
+    if (result != ZE_RESULT_SUCCESS) {
+      std::cerr << "WARNING: fabric ports of device " << d
+                << " not available: " << result << std::endl;
+      continue;
+    }
+    std::vector<zes_fabric_port_handle_t> handles(count);
+    SUCCESS_OR_TERMINATE(
+        zesDeviceEnumFabricPorts(device, &count, handles.data()));
+
+    for (auto handle : handles) {
+      zes_fabric_port_properties_t properties = {
+          ZES_STRUCTURE_TYPE_FABRIC_PORT_PROPERTIES, nullptr};
+      SUCCESS_OR_TERMINATE(zesFabricPortGetProperties(handle, &properties));
+      zes_fabric_port_state_t state = {ZES_STRUCTURE_TYPE_FABRIC_PORT_STATE,
+                                       nullptr};
+      SUCCESS_OR_TERMINATE(zesFabricPortGetState(handle, &state));
+
+      fabric_port_t port = {};
+      port.device_id = d;
+      port.handle = handle;
+      port.name = port_name(properties.portId);
+      port.remote_name = port_name(state.remotePortId);
+      port.rx_speed = link_speed(state.rxSpeed, properties.maxRxSpeed);
+      port.tx_speed = link_speed(state.txSpeed, properties.maxTxSpeed);
+      fabric_ports.push_back(port);
+    }
+  }
+}
+
+void ZePeer::start_fabric_counters() {
+  for (auto &port : fabric_ports) {
+    SUCCESS_OR_TERMINATE(zesFabricPortGetThroughput(port.handle, &port.start));
+  }
+}
+
+// Prints the bytes each port received and transmitted since
+// start_fabric_counters, with its throughput and utilization of the link
+// speed. Ports which carried no traffic are left out, so the list shows the
+// route taken. Bytes cross one link per hop, so the total transmitted over
+// the application bytes is above one when traffic is routed over several
+// hops.
+void ZePeer::print_fabric_counters(bool bidirectional, size_t buffer_size) {
+  if (!sample_fabric_counters) {
+    return;
+  }
+  long double application_bytes =
+      static_cast<long double>(buffer_size) * number_iterations;
+  if (bidirectional) {
+    application_bytes = 2 * application_bytes;
+  }
+  long double link_bytes = 0;
+
+  for (auto &port : fabric_ports) {
+    zes_fabric_port_throughput_t end = {};
+    SUCCESS_OR_TERMINATE(zesFabricPortGetThroughput(port.handle, &end));
+    long double rx_bytes =
+        static_cast<long double>(end.rxCounter - port.start.rxCounter);
+    long double tx_bytes =
+        static_cast<long double>(end.txCounter - port.start.txCounter);
+    long double time_s =
+        static_cast<long double>(end.timestamp - port.start.timestamp) / 1e6;
+    if (rx_bytes == 0 && tx_bytes == 0) {
+      continue;
+    }
+    link_bytes += tx_bytes;
+
+    long double rx_bandwidth = time_s > 0 ? rx_bytes / time_s : 0;
+    long double tx_bandwidth = time_s > 0 ? tx_bytes / time_s : 0;
+    std::cout << "  Fabric port " << port.name << " (device "
+              << port.device_id << ") <-> " << port.remote_name
+              << ": rx [GB]: " << std::fixed << std::setw(8)
+              << std::setprecision(2) << rx_bytes / ONE_GB
+              << " tx [GB]: " << std::setw(8) << tx_bytes / ONE_GB
+              << " rx [GBPS]: " << std::setw(8) << rx_bandwidth / ONE_GB
+              << " tx [GBPS]: " << std::setw(8) << tx_bandwidth / ONE_GB;
+    if (port.rx_speed > 0 && port.tx_speed > 0) {
+      std::cout << " utilization rx/tx [%]: " << std::setw(6)
+                << std::setprecision(1) << rx_bandwidth * 100 / port.rx_speed
+                << "/" << std::setw(6) << tx_bandwidth * 100 / port.tx_speed;
+    }
+    std::cout << std::endl;
+  }
+
+  if (link_bytes == 0) {
+    std::cout << "  Fabric ports: no traffic" << std::endl;
+    return;
+  }
+  std::cout << "  Fabric total tx [GB]: " << std::fixed << std::setw(8)
+            << std::setprecision(2) << link_bytes / ONE_GB
+            << " application [GB]: " << std::setw(8)
+            << application_bytes / ONE_GB
+            << " ratio: " << link_bytes / application_bytes << std::endl;
+}
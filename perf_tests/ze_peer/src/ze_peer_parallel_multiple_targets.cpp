@@ -216,6 +216,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_multiple_targets(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       queue_index_iter = 0;
@@ -356,6 +357,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_multiple_targets(
       }
     }
     print_results(true, test_type, total_buffer_size, timer);
+    print_fabric_counters(true, total_buffer_size);
   } while (run_continuously);
 
   for (auto local_device_id : local_device_ids) {
@@ -489,6 +491,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_multiple_targets_immediate(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
@@ -682,6 +685,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_multiple_targets_immediate(
       }
     }
     print_results(true, test_type, total_buffer_size, timer);
+    print_fabric_counters(true, total_buffer_size);
   } while (run_continuously);
 }
 
@@ -860,6 +864,7 @@ void ZePeer::perform_parallel_copy_to_multiple_targets(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       queue_index_iter = 0;
@@ -1002,6 +1007,7 @@ void ZePeer::perform_parallel_copy_to_multiple_targets(
       }
     }
     print_results(false, test_type, total_buffer_size, timer);
+    print_fabric_counters(false, total_buffer_size);
   } while (run_continuously);
 
   for (auto local_device_id : local_device_ids) {
@@ -1142,6 +1148,7 @@ void ZePeer::perform_parallel_copy_to_multiple_targets_immediate(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
@@ -1292,6 +1299,7 @@ void ZePeer::perform_parallel_copy_to_multiple_targets_immediate(
       }
     }
     print_results(false, test_type, total_buffer_size, timer);
+    print_fabric_counters(false, total_buffer_size);
   } while (run_continuously);
 }
 
@@ -196,6 +196,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_pair_targets(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       queue_index_iter = 0;
@@ -308,6 +309,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_pair_targets(
                     times[local_device_id][remote_device_id]);
     }
     print_results(true, test_type, total_buffer_size, timer);
+    print_fabric_counters(true, total_buffer_size);
   } while (run_continuously);
 
   for (auto pair_device_id : pair_device_ids) {
@@ -472,6 +474,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_pair_targets_immediate(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       queue_index_iter = 0;
@@ -637,6 +640,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_pair_targets_immediate(
                     times[local_device_id][remote_device_id]);
     }
     print_results(true, test_type, total_buffer_size, timer);
+    print_fabric_counters(true, total_buffer_size);
   } while (run_continuously);
 }
 
@@ -796,6 +800,7 @@ void ZePeer::perform_parallel_copy_to_pair_targets(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       queue_index_iter = 0;
@@ -910,6 +915,7 @@ void ZePeer::perform_parallel_copy_to_pair_targets(
                     times[local_device_id][remote_device_id]);
     }
     print_results(false, test_type, total_buffer_size, timer);
+    print_fabric_counters(false, total_buffer_size);
   } while (run_continuously);
 
   for (auto pair_device_id : pair_device_ids) {
@@ -1037,6 +1043,7 @@ void ZePeer::perform_parallel_copy_to_pair_targets_immediate(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
@@ -1159,6 +1166,7 @@ void ZePeer::perform_parallel_copy_to_pair_targets_immediate(
                     times[local_device_id][remote_device_id]);
     }
     print_results(false, test_type, total_buffer_size, timer);
+    print_fabric_counters(false, total_buffer_size);
   } while (run_continuously);
 }
 
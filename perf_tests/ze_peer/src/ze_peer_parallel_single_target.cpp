@@ -87,6 +87,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_single_target(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       for (size_t e = 0; e < num_engines; e++) {
@@ -115,6 +116,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_single_target(
     timer.end();
 
     print_results(true, test_type, buffer_size, timer);
+    print_fabric_counters(true, buffer_size);
   } while (run_continuously);
 
   for (size_t e = 0; e < num_engines; e++) {
@@ -191,6 +193,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_single_target_immediate(
   }
 
   do {
+    start_fabric_counters();
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
@@ -250,6 +253,7 @@ void ZePeer::perform_bidirectional_parallel_copy_to_single_target_immediate(
     timer.end();
 
     print_results(true, test_type, buffer_size, timer);
+    print_fabric_counters(true, buffer_size);
   } while (run_continuously);
 }
 
@@ -306,6 +310,7 @@ void ZePeer::perform_parallel_copy_to_single_target(
   }
 
   do {
+    start_fabric_counters();
     long double time_usec = 0;
     for (uint32_t i = 0U; i < number_iterations; i++) {
       for (size_t e = 0; e < num_engines; e++) {
@@ -330,6 +335,7 @@ void ZePeer::perform_parallel_copy_to_single_target(
     }
 
     print_results(false, test_type, buffer_size, time_usec);
+    print_fabric_counters(false, buffer_size);
   } while (run_continuously);
 
   for (size_t e = 0; e < num_engines; e++) {
@@ -381,6 +387,7 @@ void ZePeer::perform_parallel_copy_to_single_target_immediate(
   }
 
   do {
+    start_fabric_counters();
     long double time_usec = 0;
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeEventHostReset(event));
@@ -407,6 +414,7 @@ void ZePeer::perform_parallel_copy_to_single_target_immediate(
     }
 
     print_results(false, test_type, buffer_size, time_usec);
+    print_fabric_counters(false, buffer_size);
   } while (run_continuously);
 }
 
@@ -18,6 +18,8 @@ void ZePeer::perform_copy(peer_test_t test_type,
   SUCCESS_OR_TERMINATE(zeCommandListClose(command_list));
 
   Timer<std::chrono::microseconds::period> timer;
+  uint64_t expected_checksum =
+      validate_results ? ZeChecksum::host(ze_host_buffer, buffer_size) : 0;
 
   /* Warm up */
   for (uint32_t i = 0U; i < warm_up_iterations; i++) {
@@ -28,16 +30,24 @@ void ZePeer::perform_copy(peer_test_t test_type,
   }
 
   do {
+    start_fabric_counters();
+    long double verify_usec = 0;
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
           command_queue, 1, &command_list, nullptr));
       SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(
           command_queue, std::numeric_limits<uint64_t>::max()));
+      if (validate_results) {
+        verify_usec +=
+            verify_iteration(dst_buffer, buffer_size, expected_checksum);
+      }
     }
     timer.end();
 
-    print_results(false, test_type, buffer_size, timer);
+    print_results(false, test_type, buffer_size,
+                  timer.period_minus_overhead() - verify_usec);
+    print_fabric_counters(false, buffer_size);
   } while (run_continuously);
 
   SUCCESS_OR_TERMINATE(zeCommandListReset(command_list));
@@ -48,6 +58,8 @@ void ZePeer::perform_copy_immediate(peer_test_t test_type,
                                     void *dst_buffer, void *src_buffer,
                                     size_t buffer_size) {
   Timer<std::chrono::microseconds::period> timer;
+  uint64_t expected_checksum =
+      validate_results ? ZeChecksum::host(ze_host_buffer, buffer_size) : 0;
 
   /* Warm up */
   for (uint32_t i = 0U; i < warm_up_iterations; i++) {
@@ -59,6 +71,8 @@ void ZePeer::perform_copy_immediate(peer_test_t test_type,
   }
 
   do {
+    start_fabric_counters();
+    long double verify_usec = 0;
     timer.start();
     for (uint32_t i = 0U; i < number_iterations; i++) {
       SUCCESS_OR_TERMINATE(
@@ -66,10 +80,16 @@ void ZePeer::perform_copy_immediate(peer_test_t test_type,
                                         buffer_size, nullptr, 0, nullptr));
       SUCCESS_OR_TERMINATE(zeCommandListHostSynchronize(
           command_list, std::numeric_limits<uint64_t>::max()));
+      if (validate_results) {
+        verify_usec +=
+            verify_iteration(dst_buffer, buffer_size, expected_checksum);
+      }
     }
     timer.end();
 
-    print_results(false, test_type, buffer_size, timer);
+    print_results(false, test_type, buffer_size,
+                  timer.period_minus_overhead() - verify_usec);
+    print_fabric_counters(false, buffer_size);
   } while (run_continuously);
 
   SUCCESS_OR_TERMINATE(zeCommandListReset(command_list));
@@ -112,6 +132,7 @@ void ZePeer::bandwidth_latency(peer_test_t test_type,
   }
 
   if (validate_results) {
+    report_iteration_errors();
     if (ZePeer::use_immediate_cmdlist) {
       validate_buffer_immediate(command_list, ze_host_validate_buffer,
                                 dst_buffer, ze_host_buffer, buffer_size);
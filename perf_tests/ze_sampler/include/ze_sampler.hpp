@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_SAMPLER_HPP
+#define ZE_SAMPLER_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+struct sampler_config_t {
+  bool buffer; /* manual reads from a buffer instead of a sampler */
+  ze_sampler_filter_mode_t filter_mode;
+  bool normalized;
+  ze_sampler_address_mode_t address_mode;
+};
+
+struct image_data_t {
+  uint32_t dims; /* 2 or 3 */
+  uint32_t width;
+  uint32_t height;
+  uint32_t depth;
+  ze_image_handle_t image = nullptr;
+  void *input_buffer = nullptr; /* same texels as the image */
+  void *output_buffer = nullptr;
+};
+
+class ZeSampler {
+public:
+  ZeSampler();
+  ~ZeSampler();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  uint32_t image_size_2d = 2048;
+  uint32_t image_size_3d = 128;
+  float shift = 0.25f;
+  uint32_t number_iterations = 20;
+  bool report_rejected = false;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  void image_setup(image_data_t &data);
+  void image_cleanup(image_data_t &data);
+  long double measure(const sampler_config_t &config,
+                      const image_data_t &data);
+  void report(const sampler_config_t &config, const image_data_t &data,
+              long double texels_per_second, long double buffer_rate);
+
+  ZeApp *benchmark;
+  bool sampler_supported = false;
+  ze_device_image_properties_t image_properties = {};
+  std::vector<sampler_config_t> configs;
+  ze_kernel_handle_t sample_2d = nullptr;
+  ze_kernel_handle_t sample_3d = nullptr;
+  ze_kernel_handle_t buffer_nearest_2d = nullptr;
+  ze_kernel_handle_t buffer_nearest_3d = nullptr;
+  ze_kernel_handle_t buffer_linear_2d = nullptr;
+  ze_kernel_handle_t buffer_linear_3d = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+};
+
+#endif /* ZE_SAMPLER_HPP */
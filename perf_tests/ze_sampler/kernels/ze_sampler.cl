@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+/* Hardware sampling: coordinates are ((x, y, z) + offset) * scale, the host
+   picks offset and scale for normalized or unnormalized coordinates. */
+kernel void sample_2d(read_only image2d_t input, sampler_t sampler,
+                      global float4 *output, float2 offset, float2 scale) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int w = get_global_size(0);
+  const float2 coord = ((float2)(x, y) + offset) * scale;
+  output[y * w + x] = read_imagef(input, sampler, coord);
+}
+
+kernel void sample_3d(read_only image3d_t input, sampler_t sampler,
+                      global float4 *output, float4 offset, float4 scale) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int z = get_global_id(2);
+  const int w = get_global_size(0);
+  const int h = get_global_size(1);
+  const float4 coord = ((float4)(x, y, z, 0.0f) + offset) * scale;
+  output[(z * h + y) * w + x] = read_imagef(input, sampler, coord);
+}
+
+/* Manual equivalents on a buffer holding the same texels, with clamp to edge
+   addressing and unnormalized coordinates. */
+kernel void buffer_nearest_2d(const global float4 *input,
+                              global float4 *output, float2 offset) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int w = get_global_size(0);
+  const int h = get_global_size(1);
+  const int tx = clamp((int)floor(x + offset.x), 0, w - 1);
+  const int ty = clamp((int)floor(y + offset.y), 0, h - 1);
+  output[y * w + x] = input[ty * w + tx];
+}
+
+kernel void buffer_nearest_3d(const global float4 *input,
+                              global float4 *output, float4 offset) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int z = get_global_id(2);
+  const int w = get_global_size(0);
+  const int h = get_global_size(1);
+  const int d = get_global_size(2);
+  const int tx = clamp((int)floor(x + offset.x), 0, w - 1);
+  const int ty = clamp((int)floor(y + offset.y), 0, h - 1);
+  const int tz = clamp((int)floor(z + offset.z), 0, d - 1);
+  output[(z * h + y) * w + x] = input[(tz * h + ty) * w + tx];
+}
+
+kernel void buffer_linear_2d(const global float4 *input,
+                             global float4 *output, float2 offset) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int w = get_global_size(0);
+  const int h = get_global_size(1);
+  const float u = x + offset.x - 0.5f;
+  const float v = y + offset.y - 0.5f;
+  const float fu = floor(u);
+  const float fv = floor(v);
+  const int x0 = clamp((int)fu, 0, w - 1);
+  const int x1 = clamp((int)fu + 1, 0, w - 1);
+  const int y0 = clamp((int)fv, 0, h - 1);
+  const int y1 = clamp((int)fv + 1, 0, h - 1);
+  const float4 a = (float4)(u - fu);
+  const float4 b = (float4)(v - fv);
+  const float4 t0 = mix(input[y0 * w + x0], input[y0 * w + x1], a);
+  const float4 t1 = mix(input[y1 * w + x0], input[y1 * w + x1], a);
+  output[y * w + x] = mix(t0, t1, b);
+}
+
+kernel void buffer_linear_3d(const global float4 *input,
+                             global float4 *output, float4 offset) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  const int z = get_global_id(2);
+  const int w = get_global_size(0);
+  const int h = get_global_size(1);
+  const int d = get_global_size(2);
+  const float u = x + offset.x - 0.5f;
+  const float v = y + offset.y - 0.5f;
+  const float s = z + offset.z - 0.5f;
+  const float fu = floor(u);
+  const float fv = floor(v);
+  const float fs = floor(s);
+  const int x0 = clamp((int)fu, 0, w - 1);
+  const int x1 = clamp((int)fu + 1, 0, w - 1);
+  const int y0 = clamp((int)fv, 0, h - 1);
+  const int y1 = clamp((int)fv + 1, 0, h - 1);
+  const int z0 = clamp((int)fs, 0, d - 1);
+  const int z1 = clamp((int)fs + 1, 0, d - 1);
+  const float4 a = (float4)(u - fu);
+  const float4 b = (float4)(v - fv);
+  const float4 c = (float4)(s - fs);
+  const global float4 *p0 = input + z0 * h * w;
+  const global float4 *p1 = input + z1 * h * w;
+  const float4 t00 = mix(p0[y0 * w + x0], p0[y0 * w + x1], a);
+  const float4 t01 = mix(p0[y1 * w + x0], p0[y1 * w + x1], a);
+  const float4 t10 = mix(p1[y0 * w + x0], p1[y0 * w + x1], a);
+  const float4 t11 = mix(p1[y1 * w + x0], p1[y1 * w + x1], a);
+  output[(z * h + y) * w + x] = mix(mix(t00, t01, b), mix(t10, t11, b), c);
+}
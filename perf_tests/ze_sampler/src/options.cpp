@@ -0,0 +1,63 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sampler.hpp"
+
+int ZeSampler::parse_command_line(int argc, char **argv) {
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "size-2d", po::value<uint32_t>(&image_size_2d)->default_value(2048),
+        "set width and height of the 2D image in texels")(
+        "size-3d", po::value<uint32_t>(&image_size_3d)->default_value(128),
+        "set width, height and depth of the 3D image in texels")(
+        "shift", po::value<float>(&shift)->default_value(0.25f, "0.25"),
+        "set sample position offset from the texel centre, in texels")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(20),
+        "set number of kernel launches per measurement")(
+        "report-rejected", po::bool_switch(&report_rejected),
+        "print why the driver rejects a sampler")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  if (image_size_2d == 0 || image_size_3d == 0 || number_iterations == 0) {
+    std::cout << "image sizes and number of iterations must be greater "
+                 "than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (sampler_supported &&
+      (image_size_2d > image_properties.maxImageDims2D ||
+       image_size_3d > image_properties.maxImageDims3D)) {
+    std::cout << "image sizes exceed the device limits of "
+              << image_properties.maxImageDims2D << " (2D) and "
+              << image_properties.maxImageDims3D << " (3D)" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
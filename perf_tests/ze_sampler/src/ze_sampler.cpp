@@ -0,0 +1,347 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sampler.hpp"
+
+static const char *filter_names[] = {"nearest", "linear"};
+static const char *address_names[] = {"none", "repeat", "clamp to edge",
+                                      "clamp to border", "mirror"};
+
+ZeSampler::ZeSampler() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_sampler.spv");
+  benchmark->singleDeviceInit();
+
+  image_properties.stype = ZE_STRUCTURE_TYPE_DEVICE_IMAGE_PROPERTIES;
+  SUCCESS_OR_TERMINATE(zeDeviceGetImageProperties(benchmark->_devices[0],
+                                                  &image_properties));
+  sampler_supported = image_properties.maxSamplers != 0;
+
+  // Buffer reads first, they are the reference for the sampler results.
+  for (ze_sampler_filter_mode_t filter :
+       {ZE_SAMPLER_FILTER_MODE_NEAREST, ZE_SAMPLER_FILTER_MODE_LINEAR}) {
+    configs.push_back({true, filter, false, ZE_SAMPLER_ADDRESS_MODE_CLAMP});
+  }
+  for (ze_sampler_filter_mode_t filter :
+       {ZE_SAMPLER_FILTER_MODE_NEAREST, ZE_SAMPLER_FILTER_MODE_LINEAR}) {
+    for (bool normalized : {false, true}) {
+      for (ze_sampler_address_mode_t address :
+           {ZE_SAMPLER_ADDRESS_MODE_NONE, ZE_SAMPLER_ADDRESS_MODE_CLAMP,
+            ZE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER,
+            ZE_SAMPLER_ADDRESS_MODE_REPEAT, ZE_SAMPLER_ADDRESS_MODE_MIRROR}) {
+        // Repeat and mirror are only defined for normalized coordinates.
+        if (!normalized && (address == ZE_SAMPLER_ADDRESS_MODE_REPEAT ||
+                            address == ZE_SAMPLER_ADDRESS_MODE_MIRROR)) {
+          continue;
+        }
+        configs.push_back({false, filter, normalized, address});
+      }
+    }
+  }
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+
+  benchmark->functionCreate(&sample_2d, "sample_2d");
+  benchmark->functionCreate(&sample_3d, "sample_3d");
+  benchmark->functionCreate(&buffer_nearest_2d, "buffer_nearest_2d");
+  benchmark->functionCreate(&buffer_nearest_3d, "buffer_nearest_3d");
+  benchmark->functionCreate(&buffer_linear_2d, "buffer_linear_2d");
+  benchmark->functionCreate(&buffer_linear_3d, "buffer_linear_3d");
+}
+
+ZeSampler::~ZeSampler() {
+  benchmark->functionDestroy(sample_2d);
+  benchmark->functionDestroy(sample_3d);
+  benchmark->functionDestroy(buffer_nearest_2d);
+  benchmark->functionDestroy(buffer_nearest_3d);
+  benchmark->functionDestroy(buffer_linear_2d);
+  benchmark->functionDestroy(buffer_linear_3d);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeSampler::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeSampler::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+// Creates an RGBA 32-bit float image and a device buffer holding the same
+// texels, so sampler and buffer kernels read identical data.
+void ZeSampler::image_setup(image_data_t &data) {
+  size_t texels = static_cast<size_t>(data.width) * data.height * data.depth;
+  size_t size = texels * 4 * sizeof(float);
+  std::vector<float> host_data(texels * 4);
+  for (size_t i = 0; i < host_data.size(); i++) {
+    host_data[i] = static_cast<float>(i % 251) / 251.0f;
+  }
+
+  ze_image_format_t format = {
+      ZE_IMAGE_FORMAT_LAYOUT_32_32_32_32, ZE_IMAGE_FORMAT_TYPE_FLOAT,
+      ZE_IMAGE_FORMAT_SWIZZLE_R,          ZE_IMAGE_FORMAT_SWIZZLE_G,
+      ZE_IMAGE_FORMAT_SWIZZLE_B,          ZE_IMAGE_FORMAT_SWIZZLE_A};
+  ze_image_desc_t image_desc = {};
+  image_desc.stype = ZE_STRUCTURE_TYPE_IMAGE_DESC;
+  image_desc.flags = 0;
+  image_desc.type = data.dims == 2 ? ZE_IMAGE_TYPE_2D : ZE_IMAGE_TYPE_3D;
+  image_desc.format = format;
+  image_desc.width = data.width;
+  image_desc.height = data.height;
+  image_desc.depth = data.depth;
+  image_desc.arraylevels = 0;
+  image_desc.miplevels = 0;
+  ze_image_region_t region = {0,          0,           0,
+                              data.width, data.height, data.depth};
+
+  if (sampler_supported) {
+    benchmark->imageCreate(&image_desc, &data.image);
+  }
+  benchmark->memoryAlloc(0, size, &data.input_buffer);
+  benchmark->memoryAlloc(0, size, &data.output_buffer);
+
+  benchmark->commandListReset(command_list);
+  if (sampler_supported) {
+    benchmark->commandListAppendImageCopyFromMemory(
+        command_list, data.image,
+        reinterpret_cast<uint8_t *>(host_data.data()), &region);
+  }
+  benchmark->commandListAppendMemoryCopy(command_list, data.input_buffer,
+                                         host_data.data(), size);
+  benchmark->commandListClose(command_list);
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+}
+
+void ZeSampler::image_cleanup(image_data_t &data) {
+  if (data.image) {
+    benchmark->imageDestroy(data.image);
+  }
+  benchmark->memoryFree(data.input_buffer);
+  benchmark->memoryFree(data.output_buffer);
+}
+
+// Returns texels per second, or 0 when the sampler cannot be created.
+long double ZeSampler::measure(const sampler_config_t &config,
+                               const image_data_t &data) {
+  Timer<std::chrono::microseconds::period> timer;
+  ze_sampler_handle_t sampler = nullptr;
+  ze_kernel_handle_t kernel = nullptr;
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+
+  // Texel centres shifted by a fraction of a texel, so linear filtering
+  // blends neighbours and addressing kicks in at the edges.
+  const float offset[4] = {0.5f + shift, 0.5f + shift, 0.5f + shift, 0.0f};
+  float scale[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+  if (config.normalized) {
+    scale[0] = 1.0f / static_cast<float>(data.width);
+    scale[1] = 1.0f / static_cast<float>(data.height);
+    scale[2] = 1.0f / static_cast<float>(data.depth);
+  }
+  size_t vector_size = (data.dims == 2 ? 2 : 4) * sizeof(float);
+
+  if (config.buffer) {
+    if (config.filter_mode == ZE_SAMPLER_FILTER_MODE_NEAREST) {
+      kernel = data.dims == 2 ? buffer_nearest_2d : buffer_nearest_3d;
+    } else {
+      kernel = data.dims == 2 ? buffer_linear_2d : buffer_linear_3d;
+    }
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 0, sizeof(data.input_buffer), &data.input_buffer));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 1, sizeof(data.output_buffer), &data.output_buffer));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 2, vector_size, offset));
+  } else {
+    ze_sampler_desc_t sampler_desc = {};
+    sampler_desc.stype = ZE_STRUCTURE_TYPE_SAMPLER_DESC;
+    sampler_desc.addressMode = config.address_mode;
+    sampler_desc.filterMode = config.filter_mode;
+    sampler_desc.isNormalized = config.normalized;
+    ze_result_t result =
+        zeSamplerCreate(benchmark->context, benchmark->_devices[0],
+                        &sampler_desc, &sampler);
+    if (result != ZE_RESULT_SUCCESS) {
+      if (report_rejected) {
+        std::cerr << "WARNING : zeSamplerCreate : " << result << std::endl;
+      }
+      return 0;
+    }
+
+    kernel = data.dims == 2 ? sample_2d : sample_3d;
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(data.image), &data.image));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 1, sizeof(sampler), &sampler));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 2, sizeof(data.output_buffer), &data.output_buffer));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 3, vector_size, offset));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 4, vector_size, scale));
+  }
+
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+      kernel, data.width, data.height, data.depth, &group_size_x,
+      &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetGroupSize(kernel, group_size_x, group_size_y, group_size_z));
+  ze_group_count_t group_count = {data.width / group_size_x,
+                                  data.height / group_size_y,
+                                  data.depth / group_size_z};
+  long double texels = static_cast<long double>(group_count.groupCountX) *
+                       group_size_x * group_count.groupCountY * group_size_y *
+                       group_count.groupCountZ * group_size_z;
+
+  benchmark->commandListReset(command_list);
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        command_list, kernel, &group_count, nullptr, 0, nullptr));
+    benchmark->commandListAppendBarrier(command_list);
+  }
+  benchmark->commandListClose(command_list);
+
+  // Warm up
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+
+  timer.start();
+  benchmark->commandQueueExecuteCommandList(command_queue, 1, &command_list);
+  benchmark->commandQueueSynchronize(command_queue);
+  timer.end();
+
+  if (sampler) {
+    SUCCESS_OR_TERMINATE(zeSamplerDestroy(sampler));
+  }
+
+  long double seconds = timer.period_minus_overhead() / 1e6;
+  return texels * number_iterations / seconds;
+}
+
+void ZeSampler::report(const sampler_config_t &config,
+                       const image_data_t &data,
+                       long double texels_per_second,
+                       long double buffer_rate) {
+  std::string name =
+      std::string(config.buffer ? "buffer " : "sampler ") +
+      filter_names[config.filter_mode];
+  if (!config.buffer) {
+    name += config.normalized ? ", normalized" : ", unnormalized";
+    name += std::string(", ") + address_names[config.address_mode];
+  }
+  std::cout << "\t" << std::left << std::setw(46) << name << std::right
+            << ":";
+  if (texels_per_second == 0) {
+    std::cout << "  not supported" << std::endl;
+    return;
+  }
+  long double relative = texels_per_second / buffer_rate;
+  std::cout << "  " << std::fixed << std::setprecision(2) << std::setw(8)
+            << texels_per_second / 1e9 << " Gtexels/s  vs buffer = "
+            << std::setprecision(3) << relative << "x" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Sampler read");
+      test_ptree.put("Dimensions", data.dims);
+      test_ptree.put("Width", data.width);
+      test_ptree.put("Height", data.height);
+      test_ptree.put("Depth", data.depth);
+      test_ptree.put("Method", config.buffer ? "buffer" : "sampler");
+      test_ptree.put("Filter", filter_names[config.filter_mode]);
+      if (!config.buffer) {
+        test_ptree.put("Normalized", config.normalized);
+        test_ptree.put("Address mode", address_names[config.address_mode]);
+      }
+      test_ptree.put("Texels per second", texels_per_second);
+      test_ptree.put("Relative to buffer", relative);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting sampler measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void ZeSampler::run(void) {
+  std::vector<image_data_t> images(2);
+  images[0].dims = 2;
+  images[0].width = image_size_2d;
+  images[0].height = image_size_2d;
+  images[0].depth = 1;
+  images[1].dims = 3;
+  images[1].width = image_size_3d;
+  images[1].height = image_size_3d;
+  images[1].depth = image_size_3d;
+
+  if (!sampler_supported) {
+    std::cout << "Device does not support samplers, only buffer reads are "
+                 "measured"
+              << std::endl;
+  }
+
+  for (image_data_t &data : images) {
+    image_setup(data);
+
+    std::cout << data.dims << "D image: " << data.width << "x" << data.height;
+    if (data.dims == 3) {
+      std::cout << "x" << data.depth;
+    }
+    std::cout << " RGBA float" << std::endl;
+
+    long double buffer_rate[2] = {0, 0};
+    for (const sampler_config_t &config : configs) {
+      if (!config.buffer && !sampler_supported) {
+        continue;
+      }
+      long double rate = measure(config, data);
+      if (config.buffer) {
+        buffer_rate[config.filter_mode] = rate;
+      }
+      report(config, data, rate, buffer_rate[config.filter_mode]);
+    }
+
+    image_cleanup(data);
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.sampler", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeSampler sampler;
+  SUCCESS_OR_TERMINATE(sampler.parse_command_line(argc, argv));
+  if (!sampler.setup_environment()) {
+    return 1;
+  }
+  sampler.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_SVM_HPP
+#define ZE_SVM_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+#include "ze_sample_stats.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum workload_t {
+  WORKLOAD_KERNEL_READ = 0,
+  WORKLOAD_KERNEL_WRITE = 1,
+  WORKLOAD_KERNEL_UPDATE = 2,
+  WORKLOAD_COPY_TO_DEVICE = 3,
+  WORKLOAD_COPY_FROM_DEVICE = 4,
+  WORKLOAD_COUNT = 5
+};
+
+enum allocation_t {
+  ALLOCATION_DEVICE = 0, /* zeMemAllocDevice, the baseline */
+  ALLOCATION_SHARED = 1, /* zeMemAllocShared */
+  ALLOCATION_SYSTEM = 2  /* aligned_alloc, shared system allocation */
+};
+
+enum first_touch_t {
+  FIRST_TOUCH_NONE = 0,   /* first access is the measured workload */
+  FIRST_TOUCH_HOST = 1,   /* memset on the host */
+  FIRST_TOUCH_DEVICE = 2  /* write kernel on the device */
+};
+
+struct svm_variant_t {
+  allocation_t allocation;
+  first_touch_t first_touch;
+};
+
+struct svm_result_t {
+  bool supported = false;
+  long double first_usec = 0;  /* first iteration, includes migration */
+  long double steady_usec = 0; /* average of the following iterations */
+  ZeSampleStats steady;       /* the following iterations */
+};
+
+class ZeSvm {
+public:
+  ZeSvm();
+  ~ZeSvm();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<size_t> working_set_sizes;
+  uint32_t number_iterations = 20;
+  std::string JsonFileName;
+  ptree param_array;
+  ZeEnvGuard env_guard;
+
+private:
+  void *allocate(allocation_t allocation, size_t size);
+  void release(allocation_t allocation, void *ptr);
+  void append_kernel(ze_command_list_handle_t list, ze_kernel_handle_t kernel,
+                     size_t size);
+  void record_workload(workload_t workload, void *ptr, size_t size);
+  void first_touch(first_touch_t first_touch, void *ptr, size_t size);
+  long double run_iteration(void);
+  svm_result_t measure(workload_t workload, const svm_variant_t &variant,
+                       size_t size);
+  void report(workload_t workload, size_t size,
+              const std::vector<svm_result_t> &results);
+
+  ZeApp *benchmark;
+  bool system_alloc_supported = false;
+  std::vector<svm_variant_t> variants;
+  ze_kernel_handle_t read_kernel = nullptr;
+  ze_kernel_handle_t write_kernel = nullptr;
+  ze_kernel_handle_t update_kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+  ze_command_list_handle_t touch_list = nullptr;
+  void *device_buffer = nullptr;
+  void *sink_buffer = nullptr;
+};
+
+#endif /* ZE_SVM_HPP */
@@ -0,0 +1,60 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_svm.hpp"
+
+int ZeSvm::parse_command_line(int argc, char **argv) {
+
+  std::vector<size_t> sizes;
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "size",
+        po::value<std::vector<size_t>>(&sizes)->multitoken()->default_value(
+            {1 << 24, 1 << 28}, "16MiB 256MiB"),
+        "set working set sizes in bytes, multiples of 4096")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(20),
+        "set number of iterations after the first one")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  for (size_t size : sizes) {
+    if (size == 0 || size % 4096 != 0) {
+      std::cout << "working set size " << size
+                << " is not a multiple of 4096" << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  if (number_iterations == 0) {
+    std::cout << "number of iterations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  working_set_sizes = sizes;
+  return 0;
+}
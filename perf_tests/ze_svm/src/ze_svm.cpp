@@ -0,0 +1,325 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_svm.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+static const char *workload_names[] = {"kernel read", "kernel write",
+                                       "kernel update", "copy to device",
+                                       "copy from device"};
+static const char *allocation_names[] = {"device", "shared", "system"};
+static const char *first_touch_names[] = {"none", "host", "device"};
+
+static const size_t sink_size = 256 * 16;
+static const size_t page_size = 4096;
+
+ZeSvm::ZeSvm() {
+  uint32_t ordinal = 0;
+  ze_device_memory_access_properties_t access_properties = {};
+  access_properties.stype = ZE_STRUCTURE_TYPE_DEVICE_MEMORY_ACCESS_PROPERTIES;
+
+  benchmark = new ZeApp("ze_memory_access.spv");
+  benchmark->singleDeviceInit();
+
+  SUCCESS_OR_TERMINATE(zeDeviceGetMemoryAccessProperties(
+      benchmark->_devices[0], &access_properties));
+  system_alloc_supported = (access_properties.sharedSystemAllocCapabilities &
+                            ZE_MEMORY_ACCESS_CAP_FLAG_RW) != 0;
+
+  // Device memory first, it is the baseline for the relative throughput.
+  variants.push_back({ALLOCATION_DEVICE, FIRST_TOUCH_DEVICE});
+  variants.push_back({ALLOCATION_DEVICE, FIRST_TOUCH_NONE});
+  for (allocation_t allocation : {ALLOCATION_SHARED, ALLOCATION_SYSTEM}) {
+    variants.push_back({allocation, FIRST_TOUCH_NONE});
+    variants.push_back({allocation, FIRST_TOUCH_HOST});
+    variants.push_back({allocation, FIRST_TOUCH_DEVICE});
+  }
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+  benchmark->commandListCreate(0, ordinal, &touch_list);
+
+  benchmark->functionCreate(&read_kernel, "read_data");
+  benchmark->functionCreate(&write_kernel, "write_data");
+  benchmark->functionCreate(&update_kernel, "read_write_data");
+}
+
+ZeSvm::~ZeSvm() {
+  benchmark->functionDestroy(read_kernel);
+  benchmark->functionDestroy(write_kernel);
+  benchmark->functionDestroy(update_kernel);
+  benchmark->commandListDestroy(touch_list);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeSvm::is_json_output_enabled(void) { return JsonFileName.size() != 0; }
+
+void *ZeSvm::allocate(allocation_t allocation, size_t size) {
+  void *ptr = nullptr;
+
+  switch (allocation) {
+  case ALLOCATION_DEVICE:
+    benchmark->memoryAlloc(0, size, &ptr);
+    break;
+  case ALLOCATION_SHARED:
+    benchmark->memoryAllocShared(0, size, &ptr);
+    break;
+  case ALLOCATION_SYSTEM:
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, page_size);
+#else
+    ptr = aligned_alloc(page_size, size);
+#endif
+    if (ptr == nullptr) {
+      std::cerr << "ERROR: system allocation of " << size << " bytes failed"
+                << std::endl;
+      std::terminate();
+    }
+    break;
+  }
+  return ptr;
+}
+
+void ZeSvm::release(allocation_t allocation, void *ptr) {
+  if (allocation == ALLOCATION_SYSTEM) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+  } else {
+    benchmark->memoryFree(ptr);
+  }
+}
+
+void ZeSvm::append_kernel(ze_command_list_handle_t list,
+                          ze_kernel_handle_t kernel, size_t size) {
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+  uint32_t elements = static_cast<uint32_t>(size / 16);
+
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+      kernel, elements, 1, 1, &group_size_x, &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, group_size_x, 1, 1));
+  ze_group_count_t group_count = {elements / group_size_x, 1, 1};
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      list, kernel, &group_count, nullptr, 0, nullptr));
+}
+
+void ZeSvm::record_workload(workload_t workload, void *ptr, size_t size) {
+  const uint32_t value = 0x5a5a5a5a;
+
+  benchmark->commandListReset(command_list);
+  switch (workload) {
+  case WORKLOAD_KERNEL_READ:
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(read_kernel, 0, sizeof(ptr), &ptr));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        read_kernel, 1, sizeof(sink_buffer), &sink_buffer));
+    append_kernel(command_list, read_kernel, size);
+    break;
+  case WORKLOAD_KERNEL_WRITE:
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(write_kernel, 0, sizeof(ptr), &ptr));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(write_kernel, 1, sizeof(value), &value));
+    append_kernel(command_list, write_kernel, size);
+    break;
+  case WORKLOAD_KERNEL_UPDATE:
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(update_kernel, 0, sizeof(ptr), &ptr));
+    append_kernel(command_list, update_kernel, size);
+    break;
+  case WORKLOAD_COPY_TO_DEVICE:
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+        command_list, device_buffer, ptr, size, nullptr, 0, nullptr));
+    break;
+  case WORKLOAD_COPY_FROM_DEVICE:
+    SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+        command_list, ptr, device_buffer, size, nullptr, 0, nullptr));
+    break;
+  default:
+    break;
+  }
+  benchmark->commandListClose(command_list);
+}
+
+void ZeSvm::first_touch(first_touch_t first_touch, void *ptr, size_t size) {
+  const uint32_t value = 0;
+
+  switch (first_touch) {
+  case FIRST_TOUCH_HOST:
+    memset(ptr, 0, size);
+    break;
+  case FIRST_TOUCH_DEVICE:
+    benchmark->commandListReset(touch_list);
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(write_kernel, 0, sizeof(ptr), &ptr));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(write_kernel, 1, sizeof(value), &value));
+    append_kernel(touch_list, write_kernel, size);
+    benchmark->commandListClose(touch_list);
+    benchmark->commandQueueExecuteCommandList(command_queue, 1, &touch_list);
+    benchmark->commandQueueSynchronize(command_queue);
+    break;
+  default:
+    break;
+  }
+}
+
+long double ZeSvm::run_iteration(void) {
+  Timer<std::chrono::microseconds::period> timer;
+
+  timer.start();
+  SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+      command_queue, 1, &command_list, nullptr));
+  SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+  timer.end();
+
+  return timer.period_minus_overhead();
+}
+
+// Every measurement uses a fresh allocation, so the first iteration pays for
+// whatever placement or migration the first touch variant leaves behind.
+svm_result_t ZeSvm::measure(workload_t workload, const svm_variant_t &variant,
+                            size_t size) {
+  svm_result_t result;
+
+  if (variant.allocation == ALLOCATION_SYSTEM && !system_alloc_supported) {
+    return result;
+  }
+
+  void *ptr = allocate(variant.allocation, size);
+  first_touch(variant.first_touch, ptr, size);
+  record_workload(workload, ptr, size);
+
+  result.supported = true;
+  result.first_usec = run_iteration();
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    result.steady.add(run_iteration());
+  }
+  result.steady_usec = result.steady.mean;
+
+  release(variant.allocation, ptr);
+  return result;
+}
+
+void ZeSvm::report(workload_t workload, size_t size,
+                   const std::vector<svm_result_t> &results) {
+  const svm_result_t &baseline = results[0];
+
+  std::cout << "Workload: " << workload_names[workload]
+            << "  Working set: " << size << " bytes" << std::endl;
+  for (size_t v = 0; v < variants.size(); v++) {
+    const svm_result_t &result = results[v];
+    std::string name =
+        std::string(allocation_names[variants[v].allocation]) +
+        ", first touch " + first_touch_names[variants[v].first_touch];
+    std::cout << "\t" << std::left << std::setw(29) << name << std::right
+              << ":";
+    if (!result.supported) {
+      std::cout << "  not supported" << std::endl;
+      continue;
+    }
+    long double bandwidth = size / result.steady_usec / 1e3;
+    long double relative = baseline.steady_usec / result.steady_usec;
+    long double migration_usec =
+        std::max(result.first_usec - result.steady_usec, 0.0L);
+    std::cout << "  " << std::fixed << std::setprecision(2) << std::setw(8)
+              << bandwidth << " GB/s  relative = " << std::setprecision(3)
+              << relative << "  migration = " << std::setprecision(2)
+              << std::setw(11) << migration_usec << " usec" << std::endl;
+
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "SVM parity");
+        test_ptree.put("Workload", workload_names[workload]);
+        test_ptree.put("Allocation", allocation_names[variants[v].allocation]);
+        test_ptree.put("First touch",
+                       first_touch_names[variants[v].first_touch]);
+        test_ptree.put("Size", size);
+        test_ptree.put("GBPS", bandwidth);
+        test_ptree.put("Relative throughput", relative);
+        test_ptree.put("First iteration(usec)", result.first_usec);
+        test_ptree.put("Steady state(usec)", result.steady_usec);
+        result.steady.add_to(test_ptree, "Steady state(usec)");
+        test_ptree.put("Migration cost(usec)", migration_usec);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting SVM measurement: " << e.what()
+                  << std::endl;
+      }
+    }
+  }
+}
+
+bool ZeSvm::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+void ZeSvm::run(void) {
+  size_t max_size =
+      *std::max_element(working_set_sizes.begin(), working_set_sizes.end());
+  benchmark->memoryAlloc(0, max_size, &device_buffer);
+  benchmark->memoryAlloc(0, sink_size, &sink_buffer);
+
+  if (!system_alloc_supported) {
+    std::cout << "Device does not support shared system allocation, system "
+                 "memory is skipped"
+              << std::endl;
+  }
+
+  for (size_t size : working_set_sizes) {
+    for (int w = 0; w < WORKLOAD_COUNT; w++) {
+      workload_t workload = static_cast<workload_t>(w);
+      std::vector<svm_result_t> results;
+      for (const svm_variant_t &variant : variants) {
+        results.push_back(measure(workload, variant, size));
+      }
+      report(workload, size, results);
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->memoryFree(device_buffer);
+  benchmark->memoryFree(sink_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.svm", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeSvm svm;
+  SUCCESS_OR_TERMINATE(svm.parse_command_line(argc, argv));
+  if (!svm.setup_environment()) {
+    return 1;
+  }
+  svm.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,284 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_SYSMAN_PERF_HPP
+#define ZE_SYSMAN_PERF_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include <level_zero/zes_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+typedef std::chrono::steady_clock::time_point time_point_t;
+
+// Like SUCCESS_OR_TERMINATE but only warns, and returns false on failure,
+// for calls made while a device setting is changed and must be restored.
+#define SUCCESS_OR_WARN(CALL) succeeded(CALL, #CALL)
+
+inline bool succeeded(ze_result_t result, const char *message) {
+  validate<false>(result, message);
+  return result == ZE_RESULT_SUCCESS;
+}
+
+// Runs restore when it goes out of scope, so that a device setting changed
+// by a test is put back on every path out of it. restore must not
+// terminate, see SUCCESS_OR_WARN.
+class restore_guard_t {
+public:
+  explicit restore_guard_t(std::function<void()> restore)
+      : restore(std::move(restore)) {}
+  ~restore_guard_t() { restore(); }
+  restore_guard_t(const restore_guard_t &) = delete;
+  restore_guard_t &operator=(const restore_guard_t &) = delete;
+
+private:
+  std::function<void()> restore;
+};
+
+struct timed_sample_t {
+  long double usec; /* time of the sample relative to a reference point */
+  double value;
+};
+
+struct transition_result_t {
+  bool settled = false;
+  bool responded = false;
+  long double settle_usec = 0;   /* until actual frequency stays in band */
+  long double response_usec = 0; /* until kernel time stays in band */
+  long double before_usec = 0;   /* kernel time at the old frequency */
+  long double after_usec = 0;    /* kernel time at the new frequency */
+  ze_result_t status = ZE_RESULT_SUCCESS; /* first call that failed */
+};
+
+struct factor_point_t {
+  double factor;
+  long double throughput; /* G units of work per second */
+  double watts;
+  bool pareto = false; /* no other point is faster at the same power */
+};
+
+struct scheduler_config_t {
+  bool change; /* false to measure the mode already in place */
+  zes_sched_mode_t mode;
+  uint32_t value_usec; /* watchdog timeout or timeslice interval */
+};
+
+struct scheduler_result_t {
+  bool valid = false;
+  bool worker_failed = false; /* a worker crashed or gave no results */
+  long double p50_usec = 0; /* latency process, submission to completion */
+  long double p99_usec = 0;
+  uint64_t latency_launches = 0;
+  uint64_t throughput_launches = 0; /* throughput process */
+  long double launches_per_sec = 0;
+  long double gflops = 0;
+};
+
+enum event_trigger_t {
+  EVENT_ENERGY_THRESHOLD = 0, /* energy counter crosses a set threshold */
+  EVENT_FREQ_THROTTLED = 1,   /* sustained power limit set to its minimum */
+  EVENT_TRIGGER_COUNT = 2
+};
+
+struct event_trial_t {
+  bool received = false;
+  long double latency_usec = 0; /* trigger until the listener wakes up */
+};
+
+struct counter_reading_t {
+  uint64_t value;     /* bytes or microseconds of activity */
+  uint64_t timestamp; /* device timestamp of the reading in usec */
+};
+
+struct telemetry_case_t {
+  std::string name;
+  ze_command_list_handle_t list;
+  double duty_cycle;
+  long double work_per_launch; /* bytes, or 0 to compare busy time */
+  std::function<bool(counter_reading_t &)> read; /* false if unsupported */
+  const char *unit;
+  long double scale; /* from counter units per usec to the reported unit */
+};
+
+struct wake_trial_t {
+  ze_result_t status = ZE_RESULT_SUCCESS; /* first failed launch */
+  long double kernel_usec = 0; /* first kernel after the idle period */
+  long double copy_usec = 0;   /* first copy after the idle period */
+  double idle_mhz = 0;         /* actual frequency at the end of idle */
+  double wake_mhz = 0;         /* actual frequency after the first kernel */
+  double idle_watts = 0;
+};
+
+struct soak_sample_t {
+  long double usec = 0; /* end of the sample since the start of the soak */
+  long double gflops = 0;
+  double watts = 0;
+  double celsius = 0;
+  double mhz = 0;
+  zes_freq_throttle_reason_flags_t throttle = 0;
+  int32_t fan_rpm = 0;
+};
+
+struct vf_engine_util_t {
+  zes_engine_group_t group;
+  double mean; /* percent active over one sample */
+  double peak; /* highest percent active over one poll interval */
+};
+
+class ZeSysmanPerf {
+public:
+  ZeSysmanPerf();
+  ~ZeSysmanPerf();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<std::string> tests;
+  uint32_t work_items = 65536;
+  uint32_t kernel_usec = 1000;
+  uint32_t number_iterations = 3;
+  uint32_t poll_usec = 1000;
+  uint32_t settle_window_msec = 1000;
+  std::vector<uint32_t> freq_steps;
+  uint32_t factor_step = 10;
+  uint32_t sample_msec = 1000;
+  size_t stream_size = 268435456;
+  uint32_t long_kernel_usec = 100000;
+  uint32_t latency_iterations = 16;
+  std::vector<uint32_t> timeout_values;
+  std::vector<uint32_t> timeslice_values;
+  std::vector<uint32_t> telemetry_intervals;
+  std::vector<uint32_t> duty_cycles;
+  std::vector<uint32_t> idle_durations;
+  uint32_t soak_sec = 300;
+  uint32_t vf_sec = 60;
+  bool diagnostics = false;
+  std::string executable;
+  std::string worker;        /* set in the worker processes of scheduler */
+  uint64_t window_start = 0; /* worker start, msec since the epoch */
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  static long double usec_since(time_point_t origin);
+  static long double percentile(std::vector<long double> values,
+                                double fraction);
+  static long double median(std::vector<long double> values);
+  static int settled_index(const std::vector<timed_sample_t> &samples,
+                           double target, double band);
+  static double watts(const zes_power_energy_counter_t &start,
+                      const zes_power_energy_counter_t &end);
+
+  zes_pwr_handle_t power_domain(uint32_t device);
+
+  void set_compute_iterations(uint32_t iterations);
+  void calibrate_compute(void);
+  void create_stream(void);
+  void destroy_stream(void);
+  long double launch(ze_command_list_handle_t list);
+  ze_result_t try_launch(ze_command_list_handle_t list, long double &usec);
+  void run_until(ze_command_list_handle_t list, double duty_cycle,
+                 const std::atomic<bool> &stop, time_point_t origin,
+                 std::vector<timed_sample_t> &launches);
+
+  /* Tests, one source file each */
+  void frequency_settle(void);
+  void performance_factor(void);
+  void scheduler_mode(void);
+  void event_latency(void);
+  void telemetry_accuracy(void);
+  void wake_latency(void);
+  void thermal_soak(void);
+  void vf_isolation(void);
+
+  transition_result_t measure_transition(zes_freq_handle_t freq, double from,
+                                         double to);
+  ze_result_t sweep_frequency(uint32_t domain, zes_freq_handle_t freq,
+                              const std::vector<double> &clocks);
+  void report_transition(uint32_t domain, uint32_t step, double from,
+                         double to, const transition_result_t &result);
+  ze_result_t measure_factor(zes_pwr_handle_t power,
+                             ze_command_list_handle_t list,
+                             long double work_per_launch,
+                             factor_point_t &point);
+  ze_result_t sweep_factor(zes_perf_handle_t domain, zes_pwr_handle_t power,
+                           std::vector<factor_point_t> &compute,
+                           std::vector<factor_point_t> &stream);
+  void report_factor(uint32_t domain, const std::string &engines,
+                     const std::string &workload,
+                     const std::vector<factor_point_t> &points,
+                     bool complete);
+  void run_worker(void);
+  scheduler_result_t measure_scheduler(void);
+  void report_scheduler(const scheduler_config_t &config,
+                        const scheduler_result_t &result);
+  event_trial_t trigger_event(event_trigger_t trigger, zes_pwr_handle_t power);
+  void report_event(event_trigger_t trigger,
+                    const std::vector<event_trial_t> &trials);
+  void listen_cost(uint32_t devices, uint64_t timeout_msec);
+  void telemetry_case(const telemetry_case_t &test_case);
+  wake_trial_t measure_wake(zes_freq_handle_t freq, zes_pwr_handle_t power,
+                            ze_command_list_handle_t copy_list,
+                            uint32_t idle_msec);
+  ze_result_t sweep_idle(const std::string &mode, zes_freq_handle_t freq,
+                         zes_pwr_handle_t power,
+                         ze_command_list_handle_t copy_list);
+  void report_wake(const std::string &mode, uint32_t idle_msec,
+                   long double warm_kernel_usec, long double warm_copy_usec,
+                   const std::vector<wake_trial_t> &trials);
+  void report_soak_sample(const soak_sample_t &sample);
+  void report_soak(const std::vector<soak_sample_t> &samples);
+  void vf_sampler(const std::vector<zes_vf_handle_t> &handles);
+  void vf_victim(void);
+  void report_vf_bin(uint64_t end_msec, uint32_t vf_id,
+                     const std::vector<vf_engine_util_t> &engines,
+                     uint64_t mem_bytes);
+
+  ZeApp *benchmark;
+  ze_driver_handle_t driver = nullptr;
+  std::vector<zes_device_handle_t> sysman_devices;
+  static const uint64_t worker_start_msec = 5000;
+  static const uint64_t event_timeout_msec = 5000;
+  static const size_t wake_copy_bytes = 4096;
+
+  ze_kernel_handle_t compute_kernel = nullptr;
+  uint32_t compute_ordinal = 0;
+  uint32_t compute_iterations = 0;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t compute_list = nullptr;
+  void *output_buffer = nullptr;
+  ze_kernel_handle_t stream_kernel = nullptr;
+  ze_command_list_handle_t stream_list = nullptr;
+  void *stream_src = nullptr;
+  void *stream_dst = nullptr;
+  long double stream_bytes = 0; /* bytes read and written per launch */
+  /* first failed launch of the last run_until, which then stops */
+  std::atomic<ze_result_t> workload_result{ZE_RESULT_SUCCESS};
+};
+
+#endif /* ZE_SYSMAN_PERF_HPP */
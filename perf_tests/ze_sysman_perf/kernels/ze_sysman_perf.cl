@@ -0,0 +1,22 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+kernel void compute_loop(global float *output, uint iterations) {
+  float x = (float)get_global_id(0);
+  float y = 1.0f;
+  for (uint i = 0; i < iterations; i++) {
+    x = mad(y, x, y);
+    y = mad(x, y, x);
+  }
+  output[get_global_id(0)] = y;
+}
+
+kernel void stream_copy(global const float4 *src, global float4 *dst) {
+  const size_t i = get_global_id(0);
+  dst[i] = src[i];
+}
@@ -0,0 +1,282 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <ctime>
+
+static const char *trigger_names[] = {"energy threshold", "freq throttled"};
+static const zes_event_type_flags_t trigger_events[] = {
+    ZES_EVENT_TYPE_FLAG_ENERGY_THRESHOLD_CROSSED,
+    ZES_EVENT_TYPE_FLAG_FREQ_THROTTLED};
+
+struct listen_result_t {
+  ze_result_t result = ZE_RESULT_NOT_READY;
+  zes_event_type_flags_t events = 0;
+  time_point_t wakeup;
+};
+
+static void listen_once(ze_driver_handle_t driver, zes_device_handle_t device,
+                        uint64_t timeout_msec, listen_result_t *listened) {
+  uint32_t count = 0;
+
+  listened->result = zesDriverEventListenEx(driver, timeout_msec, 1, &device,
+                                            &count, &listened->events);
+  listened->wakeup = std::chrono::steady_clock::now();
+}
+
+// Host time at which the energy counter crossed threshold, interpolated
+// between the device timestamps of the last reading below it and the first
+// one above it, and placed relative to when that reading was taken.
+static time_point_t crossing_time(const zes_power_energy_counter_t &below,
+                                  const zes_power_energy_counter_t &above,
+                                  time_point_t read_above, double threshold) {
+  const double joules_below = static_cast<double>(below.energy) / 1e6;
+  const double joules_above = static_cast<double>(above.energy) / 1e6;
+  double fraction = 1.0;
+  if (joules_above > joules_below) {
+    fraction = (threshold - joules_below) / (joules_above - joules_below);
+  }
+  const double crossing_usec =
+      static_cast<double>(below.timestamp) +
+      fraction * static_cast<double>(above.timestamp - below.timestamp);
+  return read_above -
+         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+             std::chrono::duration<double, std::micro>(
+                 static_cast<double>(above.timestamp) - crossing_usec));
+}
+
+// The listener is blocked in zesDriverEventListenEx while compute_loop runs
+// before the event is triggered. The energy threshold is set 1 J above the
+// current counter and the crossing is detected by polling the counter, the
+// throttle event is caused by lowering the sustained power limit to its
+// minimum. Both settings are put back before the trial returns.
+event_trial_t ZeSysmanPerf::trigger_event(event_trigger_t trigger,
+                                          zes_pwr_handle_t power) {
+  event_trial_t trial;
+  std::vector<timed_sample_t> launches;
+  std::atomic<bool> stop(false);
+  listen_result_t listened;
+  time_point_t triggered;
+  ze_result_t result = ZE_RESULT_SUCCESS;
+
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEventRegister(sysman_devices[0], trigger_events[trigger]));
+  time_point_t origin = std::chrono::steady_clock::now();
+  std::thread workload(&ZeSysmanPerf::run_until, this, compute_list, 1.0,
+                       std::cref(stop), origin, std::ref(launches));
+  std::thread listener(listen_once, driver, sysman_devices[0],
+                       event_timeout_msec, &listened);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  {
+    zes_energy_threshold_t original_threshold = {};
+    zes_power_sustained_limit_t original_limit = {};
+    bool threshold_set = false;
+    bool limit_set = false;
+    // A threshold of 0 disables the event, as it was before the trial.
+    restore_guard_t restore([&]() {
+      if (threshold_set) {
+        SUCCESS_OR_WARN(zesPowerSetEnergyThreshold(
+            power, original_threshold.enable ? original_threshold.threshold
+                                             : 0.0));
+      }
+      if (limit_set) {
+        SUCCESS_OR_WARN(
+            zesPowerSetLimits(power, &original_limit, nullptr, nullptr));
+      }
+    });
+
+    if (trigger == EVENT_ENERGY_THRESHOLD) {
+      zes_power_energy_counter_t below = {};
+      zes_power_energy_counter_t energy = {};
+      result = zesPowerGetEnergyThreshold(power, &original_threshold);
+      if (result == ZE_RESULT_SUCCESS) {
+        result = zesPowerGetEnergyCounter(power, &energy);
+      }
+      const double threshold = static_cast<double>(energy.energy) / 1e6 + 1.0;
+      if (result == ZE_RESULT_SUCCESS) {
+        result = zesPowerSetEnergyThreshold(power, threshold);
+        threshold_set = result == ZE_RESULT_SUCCESS;
+      }
+      time_point_t read = std::chrono::steady_clock::now();
+      while (result == ZE_RESULT_SUCCESS &&
+             static_cast<double>(energy.energy) / 1e6 < threshold &&
+             usec_since(origin) < event_timeout_msec * 1000.0L) {
+        std::this_thread::sleep_for(std::chrono::microseconds(poll_usec));
+        below = energy;
+        result = zesPowerGetEnergyCounter(power, &energy);
+        read = std::chrono::steady_clock::now();
+      }
+      triggered = crossing_time(below, energy, read, threshold);
+    } else {
+      zes_power_properties_t properties = {};
+      properties.stype = ZES_STRUCTURE_TYPE_POWER_PROPERTIES;
+      result = zesPowerGetProperties(power, &properties);
+      if (result == ZE_RESULT_SUCCESS) {
+        result = zesPowerGetLimits(power, &original_limit, nullptr, nullptr);
+      }
+      zes_power_sustained_limit_t limit = original_limit;
+      limit.enabled = true;
+      limit.power = properties.minLimit > 0 ? properties.minLimit
+                                            : original_limit.power / 4;
+      triggered = std::chrono::steady_clock::now();
+      if (result == ZE_RESULT_SUCCESS) {
+        result = zesPowerSetLimits(power, &limit, nullptr, nullptr);
+        limit_set = result == ZE_RESULT_SUCCESS;
+      }
+    }
+
+    listener.join();
+    stop = true;
+    workload.join();
+  }
+  SUCCESS_OR_TERMINATE(zesDeviceEventRegister(sysman_devices[0], 0));
+  SUCCESS_OR_TERMINATE(workload_result.load());
+
+  if (result != ZE_RESULT_SUCCESS && diagnostics) {
+    std::cerr << "WARNING : " << trigger_names[trigger] << " trigger : "
+              << result << std::endl;
+  }
+  trial.received = result == ZE_RESULT_SUCCESS &&
+                   listened.result == ZE_RESULT_SUCCESS &&
+                   (listened.events & trigger_events[trigger]);
+  trial.latency_usec = std::chrono::duration<long double, std::micro>(
+                           listened.wakeup - triggered)
+                           .count();
+  return trial;
+}
+
+void ZeSysmanPerf::report_event(event_trigger_t trigger,
+                                const std::vector<event_trial_t> &trials) {
+  std::vector<long double> latencies;
+  for (const event_trial_t &trial : trials) {
+    if (trial.received) {
+      latencies.push_back(trial.latency_usec);
+    }
+  }
+
+  std::cout << "[" << std::left << std::setw(16) << trigger_names[trigger]
+            << std::right << "]:";
+  if (latencies.empty()) {
+    std::cout << "  not supported" << std::endl;
+    return;
+  }
+  long double latency_median = median(latencies);
+  long double latency_max = percentile(latencies, 1.0);
+  std::cout << "  received " << latencies.size() << "/" << trials.size()
+            << "  latency median = " << std::fixed << std::setprecision(1)
+            << std::setw(10) << latency_median << " usec  max = "
+            << std::setw(10) << latency_max << " usec" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Event latency");
+      test_ptree.put("Trigger", trigger_names[trigger]);
+      test_ptree.put("Received", latencies.size());
+      test_ptree.put("Triggered", trials.size());
+      test_ptree.put("Latency median(usec)", latency_median);
+      test_ptree.put("Latency max(usec)", latency_max);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting event latency measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// A single thread listens on the first devices for sample_msec, blocking in
+// zesDriverEventListenEx with the given timeout, or polling every poll_usec
+// with a zero timeout. No event is expected, so this is the idle cost.
+void ZeSysmanPerf::listen_cost(uint32_t devices, uint64_t timeout_msec) {
+  std::vector<zes_event_type_flags_t> events(devices);
+  uint64_t calls = 0;
+
+  std::clock_t cpu_start = std::clock();
+  time_point_t origin = std::chrono::steady_clock::now();
+  while (usec_since(origin) < sample_msec * 1000.0L) {
+    uint32_t count = 0;
+    SUCCESS_OR_TERMINATE(zesDriverEventListenEx(driver, timeout_msec, devices,
+                                                sysman_devices.data(), &count,
+                                                events.data()));
+    calls++;
+    if (timeout_msec == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(poll_usec));
+    }
+  }
+  long double cpu_usec = static_cast<long double>(std::clock() - cpu_start) *
+                         1000000.0L / CLOCKS_PER_SEC;
+  long double cpu_percent = cpu_usec * 100 / usec_since(origin);
+
+  std::cout << "[" << std::setw(3) << devices << " devices][timeout "
+            << std::setw(6) << timeout_msec << " msec]:  cpu = " << std::fixed
+            << std::setprecision(3) << std::setw(7) << cpu_percent
+            << " %  calls = " << calls << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Event listening cost");
+      test_ptree.put("Devices", devices);
+      test_ptree.put("Timeout(msec)", timeout_msec);
+      test_ptree.put("Calls", calls);
+      test_ptree.put("CPU(%)", cpu_percent);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting event listening measurement: "
+                << e.what() << std::endl;
+    }
+  }
+}
+
+void ZeSysmanPerf::event_latency(void) {
+  std::cout << "Event trigger to listener wakeup latency" << std::endl;
+  zes_pwr_handle_t power = power_domain(0);
+  for (int t = 0; t < EVENT_TRIGGER_COUNT; t++) {
+    event_trigger_t trigger = static_cast<event_trigger_t>(t);
+    std::vector<event_trial_t> trials;
+
+    // Skip triggers the power domain cannot drive instead of waiting for
+    // the listener timeout on every trial.
+    bool supported = power != nullptr;
+    if (supported && trigger == EVENT_ENERGY_THRESHOLD) {
+      zes_energy_threshold_t threshold = {};
+      supported =
+          zesPowerGetEnergyThreshold(power, &threshold) == ZE_RESULT_SUCCESS;
+    } else if (supported) {
+      zes_power_properties_t properties = {};
+      properties.stype = ZES_STRUCTURE_TYPE_POWER_PROPERTIES;
+      SUCCESS_OR_TERMINATE(zesPowerGetProperties(power, &properties));
+      supported = properties.canControl;
+    }
+    for (uint32_t i = 0U; supported && i < number_iterations; i++) {
+      trials.push_back(trigger_event(trigger, power));
+    }
+    report_event(trigger, trials);
+  }
+
+  std::cout << "Event listening cost" << std::endl;
+  const zes_event_type_flags_t events =
+      ZES_EVENT_TYPE_FLAG_ENERGY_THRESHOLD_CROSSED |
+      ZES_EVENT_TYPE_FLAG_FREQ_THROTTLED | ZES_EVENT_TYPE_FLAG_TEMP_CRITICAL |
+      ZES_EVENT_TYPE_FLAG_MEM_HEALTH;
+  const uint32_t device_count = static_cast<uint32_t>(sysman_devices.size());
+  for (uint32_t d = 0U; d < device_count; d++) {
+    SUCCESS_OR_TERMINATE(zesDeviceEventRegister(sysman_devices[d], events));
+  }
+  for (uint32_t devices = 1U; devices <= device_count; devices++) {
+    for (uint64_t timeout_msec :
+         {uint64_t(0), uint64_t(1), uint64_t(10), uint64_t(sample_msec)}) {
+      listen_cost(devices, timeout_msec);
+    }
+  }
+  for (uint32_t d = 0U; d < device_count; d++) {
+    SUCCESS_OR_TERMINATE(zesDeviceEventRegister(sysman_devices[d], 0));
+  }
+}
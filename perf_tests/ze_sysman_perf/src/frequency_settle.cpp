@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static double nearest_clock(const std::vector<double> &clocks, double freq) {
+  double nearest = clocks.front();
+  for (double clock : clocks) {
+    if (std::fabs(clock - freq) < std::fabs(nearest - freq)) {
+      nearest = clock;
+    }
+  }
+  return nearest;
+}
+
+static ze_result_t pin_frequency(zes_freq_handle_t freq, double clock) {
+  zes_freq_range_t range = {clock, clock};
+  return zesFrequencySetRange(freq, &range);
+}
+
+// The frequency is pinned to from while compute_loop runs back to back, then
+// switched to to. The actual frequency is polled for one settle window after
+// the switch. Kernel time before the switch and over the last quarter of the
+// window gives the two throughput levels the response is measured against.
+// A failed call ends the measurement with its result in status, the caller
+// restores the frequency range.
+transition_result_t ZeSysmanPerf::measure_transition(zes_freq_handle_t freq,
+                                                     double from, double to) {
+  transition_result_t result;
+  std::vector<timed_sample_t> launches;
+  std::vector<timed_sample_t> frequencies;
+  std::atomic<bool> stop(false);
+  const long double window_usec = settle_window_msec * 1000.0L;
+
+  result.status = pin_frequency(freq, from);
+  if (result.status != ZE_RESULT_SUCCESS) {
+    return result;
+  }
+  time_point_t start = std::chrono::steady_clock::now();
+  time_point_t origin = start + std::chrono::milliseconds(settle_window_msec);
+  std::thread workload(&ZeSysmanPerf::run_until, this, compute_list, 1.0,
+                       std::cref(stop), origin, std::ref(launches));
+
+  std::this_thread::sleep_until(origin);
+  result.status = pin_frequency(freq, to);
+  while (result.status == ZE_RESULT_SUCCESS &&
+         usec_since(origin) < window_usec) {
+    zes_freq_state_t state = {};
+    state.stype = ZES_STRUCTURE_TYPE_FREQ_STATE;
+    result.status = zesFrequencyGetState(freq, &state);
+    frequencies.push_back({usec_since(origin), state.actual});
+    std::this_thread::sleep_for(std::chrono::microseconds(poll_usec));
+  }
+  stop = true;
+  workload.join();
+  if (result.status == ZE_RESULT_SUCCESS) {
+    result.status = workload_result;
+  }
+  if (result.status != ZE_RESULT_SUCCESS) {
+    return result;
+  }
+
+  int index = settled_index(frequencies, to, 0.1 * std::fabs(to - from));
+  if (index >= 0) {
+    result.settled = true;
+    result.settle_usec = frequencies[static_cast<size_t>(index)].usec;
+  }
+
+  std::vector<long double> before;
+  std::vector<long double> after;
+  std::vector<timed_sample_t> response;
+  for (const timed_sample_t &launch : launches) {
+    if (launch.usec < 0) {
+      if (launch.usec >= -window_usec / 2) {
+        before.push_back(launch.value);
+      }
+    } else {
+      response.push_back(launch);
+      if (launch.usec >= window_usec * 3 / 4) {
+        after.push_back(launch.value);
+      }
+    }
+  }
+  result.before_usec = median(before);
+  result.after_usec = median(after);
+
+  double band = std::max(0.1 * std::fabs(static_cast<double>(
+                                   result.after_usec - result.before_usec)),
+                         0.01 * static_cast<double>(result.after_usec));
+  index = settled_index(response, static_cast<double>(result.after_usec), band);
+  if (index >= 0 && !after.empty()) {
+    result.responded = true;
+    result.response_usec = response[static_cast<size_t>(index)].usec;
+  }
+  return result;
+}
+
+void ZeSysmanPerf::report_transition(uint32_t domain, uint32_t step,
+                                     double from, double to,
+                                     const transition_result_t &result) {
+  std::cout << "[domain " << domain << "][" << std::setw(3) << step << "%]["
+            << std::fixed << std::setprecision(0) << std::setw(5) << from
+            << " -> " << std::setw(5) << to << " MHz]:";
+  if (result.settled) {
+    std::cout << "  settle = " << std::setprecision(0) << std::setw(8)
+              << result.settle_usec << " usec";
+  } else {
+    std::cout << "  settle = not settled";
+  }
+  if (result.responded) {
+    std::cout << "  response = " << std::setprecision(0) << std::setw(8)
+              << result.response_usec << " usec";
+  } else {
+    std::cout << "  response = not settled";
+  }
+  std::cout << "  kernel = " << std::setprecision(1) << result.before_usec
+            << " -> " << result.after_usec << " usec" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Frequency settle");
+      test_ptree.put("Domain", domain);
+      test_ptree.put("Step(%)", step);
+      test_ptree.put("From(MHz)", from);
+      test_ptree.put("To(MHz)", to);
+      test_ptree.put("Settled", result.settled);
+      test_ptree.put("Settle(usec)", result.settle_usec);
+      test_ptree.put("Responded", result.responded);
+      test_ptree.put("Response(usec)", result.response_usec);
+      test_ptree.put("Kernel before(usec)", result.before_usec);
+      test_ptree.put("Kernel after(usec)", result.after_usec);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting frequency settle measurement: "
+                << e.what() << std::endl;
+    }
+  }
+}
+
+// Each step goes up from the lowest clock by a fraction of the clock span,
+// and back down. Stops at the first failed measurement and returns its
+// result.
+ze_result_t ZeSysmanPerf::sweep_frequency(uint32_t domain,
+                                          zes_freq_handle_t freq,
+                                          const std::vector<double> &clocks) {
+  double lowest = *std::min_element(clocks.begin(), clocks.end());
+  double highest = *std::max_element(clocks.begin(), clocks.end());
+
+  for (uint32_t step : freq_steps) {
+    double target =
+        nearest_clock(clocks, lowest + (highest - lowest) * step / 100.0);
+    if (target == lowest) {
+      continue;
+    }
+    for (uint32_t i = 0U; i < number_iterations; i++) {
+      transition_result_t up = measure_transition(freq, lowest, target);
+      if (up.status != ZE_RESULT_SUCCESS) {
+        return up.status;
+      }
+      report_transition(domain, step, lowest, target, up);
+      transition_result_t down = measure_transition(freq, target, lowest);
+      if (down.status != ZE_RESULT_SUCCESS) {
+        return down.status;
+      }
+      report_transition(domain, step, target, lowest, down);
+    }
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+void ZeSysmanPerf::frequency_settle(void) {
+  uint32_t count = 0;
+
+  std::cout << "Frequency settle time and kernel response" << std::endl;
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumFrequencyDomains(sysman_devices[0], &count, nullptr));
+  std::vector<zes_freq_handle_t> domains(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumFrequencyDomains(sysman_devices[0], &count, domains.data()));
+
+  for (uint32_t d = 0U; d < count; d++) {
+    zes_freq_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_FREQ_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesFrequencyGetProperties(domains[d], &properties));
+    if (properties.type != ZES_FREQ_DOMAIN_GPU || !properties.canControl) {
+      continue;
+    }
+
+    uint32_t clock_count = 0;
+    SUCCESS_OR_TERMINATE(
+        zesFrequencyGetAvailableClocks(domains[d], &clock_count, nullptr));
+    std::vector<double> clocks(clock_count);
+    SUCCESS_OR_TERMINATE(zesFrequencyGetAvailableClocks(
+        domains[d], &clock_count, clocks.data()));
+    if (clocks.size() < 2) {
+      continue;
+    }
+    double lowest = *std::min_element(clocks.begin(), clocks.end());
+
+    zes_freq_range_t original = {};
+    SUCCESS_OR_TERMINATE(zesFrequencyGetRange(domains[d], &original));
+    ze_result_t result = pin_frequency(domains[d], lowest);
+    if (result != ZE_RESULT_SUCCESS) {
+      std::cout << "[domain " << d << "]:  not supported" << std::endl;
+      if (diagnostics) {
+        std::cerr << "WARNING : zesFrequencySetRange : " << result
+                  << std::endl;
+      }
+      continue;
+    }
+
+    {
+      restore_guard_t restore([&]() {
+        SUCCESS_OR_WARN(zesFrequencySetRange(domains[d], &original));
+      });
+      result = sweep_frequency(d, domains[d], clocks);
+    }
+    if (result != ZE_RESULT_SUCCESS) {
+      std::cerr << "ERROR : frequency settle on domain " << d
+                << " stopped, original range restored : " << result
+                << std::endl;
+    }
+  }
+}
@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+
+static const std::vector<std::string> test_names = {
+    "freq_settle", "perf_factor", "scheduler", "events",
+    "telemetry",   "wake",        "soak",      "vf"};
+
+// Tests which take minutes, run only when named with --test
+static const std::vector<std::string> long_test_names = {"soak", "vf"};
+
+int ZeSysmanPerf::parse_command_line(int argc, char **argv) {
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  po::options_description hidden;
+  std::vector<std::string> default_tests;
+  for (const std::string &name : test_names) {
+    if (std::find(long_test_names.begin(), long_test_names.end(), name) ==
+        long_test_names.end()) {
+      default_tests.push_back(name);
+    }
+  }
+  try {
+    desc.add_options()("help", "produce help message")(
+        "test,t",
+        po::value<std::vector<std::string>>(&tests)
+            ->multitoken()
+            ->default_value(default_tests, "all but soak, vf"),
+        "set tests to run: freq_settle, perf_factor, scheduler, "
+        "events, telemetry, wake, soak, vf")(
+        "work-items", po::value<uint32_t>(&work_items)->default_value(65536),
+        "set number of work-items of the compute kernel")(
+        "kernel-usec", po::value<uint32_t>(&kernel_usec)->default_value(1000),
+        "set target duration of one compute kernel launch")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(3),
+        "set number of repetitions per measurement")(
+        "poll-usec", po::value<uint32_t>(&poll_usec)->default_value(1000),
+        "set sysman sampling interval and latency process submission "
+        "interval in microseconds")(
+        "settle-window",
+        po::value<uint32_t>(&settle_window_msec)->default_value(1000),
+        "set time in milliseconds observed before and after a frequency "
+        "change")(
+        "freq-steps",
+        po::value<std::vector<uint32_t>>(&freq_steps)
+            ->multitoken()
+            ->default_value({25, 50, 100}, "25 50 100"),
+        "set frequency steps in percent of the available clock span")(
+        "factor-step", po::value<uint32_t>(&factor_step)->default_value(10),
+        "set performance factor increment of the sweep from 0 to 100")(
+        "sample-msec", po::value<uint32_t>(&sample_msec)->default_value(1000),
+        "set duration in milliseconds of one power measurement")(
+        "stream-size",
+        po::value<size_t>(&stream_size)->default_value(268435456),
+        "set buffer size in bytes of the memory bound kernel")(
+        "long-kernel-usec",
+        po::value<uint32_t>(&long_kernel_usec)->default_value(100000),
+        "set target duration of one kernel of the throughput process")(
+        "latency-iter",
+        po::value<uint32_t>(&latency_iterations)->default_value(16),
+        "set loop iterations of the short kernel of the latency process")(
+        "timeout-usec",
+        po::value<std::vector<uint32_t>>(&timeout_values)
+            ->multitoken()
+            ->default_value({100000, 640000, 5000000},
+                            "100000 640000 5000000"),
+        "set watchdog timeouts of the timeout scheduler mode")(
+        "timeslice-usec",
+        po::value<std::vector<uint32_t>>(&timeslice_values)
+            ->multitoken()
+            ->default_value({1000, 5000, 25000}, "1000 5000 25000"),
+        "set intervals of the timeslice scheduler mode")(
+        "intervals-msec",
+        po::value<std::vector<uint32_t>>(&telemetry_intervals)
+            ->multitoken()
+            ->default_value({10, 100, 1000}, "10 100 1000"),
+        "set telemetry counter sampling intervals in milliseconds")(
+        "duty-cycles",
+        po::value<std::vector<uint32_t>>(&duty_cycles)
+            ->multitoken()
+            ->default_value({25, 50, 100}, "25 50 100"),
+        "set compute duty cycles in percent for engine utilization")(
+        "idle-msec",
+        po::value<std::vector<uint32_t>>(&idle_durations)
+            ->multitoken()
+            ->default_value({1, 10, 100, 1000}, "1 10 100 1000"),
+        "set idle durations in milliseconds before the first kernel")(
+        "soak-sec", po::value<uint32_t>(&soak_sec)->default_value(300),
+        "set duration in seconds of the thermal soak")(
+        "vf-sec", po::value<uint32_t>(&vf_sec)->default_value(60),
+        "set duration in seconds of the VF utilization and victim "
+        "throughput series")(
+        "diagnostics", po::bool_switch(&diagnostics),
+        "print why a domain or setting is reported as not supported, and the "
+        "compute kernel calibration")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+    desc.add(env_guard.options());
+
+    // Used by the worker processes of the scheduler test only.
+    hidden.add_options()("worker", po::value<std::string>(&worker))(
+        "window-start", po::value<uint64_t>(&window_start));
+    po::options_description all_options;
+    all_options.add(desc).add(hidden);
+
+    po::store(po::parse_command_line(argc, argv, all_options), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  executable = argv[0];
+  for (const std::string &test : tests) {
+    if (std::find(test_names.begin(), test_names.end(), test) ==
+        test_names.end()) {
+      std::cout << "unknown test " << test << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  for (uint32_t step : freq_steps) {
+    if (step == 0 || step > 100) {
+      std::cout << "frequency steps must be between 1 and 100" << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  for (uint32_t duty_cycle : duty_cycles) {
+    if (duty_cycle == 0 || duty_cycle > 100) {
+      std::cout << "duty cycles must be between 1 and 100" << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  if (std::find(telemetry_intervals.begin(), telemetry_intervals.end(), 0U) !=
+      telemetry_intervals.end()) {
+    std::cout << "telemetry intervals must be greater than zero" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (factor_step == 0 || factor_step > 100) {
+    std::cout << "factor step must be between 1 and 100" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (stream_size < 4 * sizeof(float) * 1024) {
+    std::cout << "stream size must be at least 16 KB" << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+  if (work_items == 0 || kernel_usec == 0 || long_kernel_usec == 0 ||
+      latency_iterations == 0 || number_iterations == 0 ||
+      settle_window_msec == 0 || sample_msec == 0 || soak_sec == 0 ||
+      vf_sec == 0) {
+    std::cout << "work-items, kernel durations and iterations, settle window, "
+                 "sample, soak and VF durations must be greater than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+static std::string engine_names(zes_engine_type_flags_t engines) {
+  static const std::vector<std::pair<zes_engine_type_flags_t, std::string>>
+      names = {{ZES_ENGINE_TYPE_FLAG_OTHER, "other"},
+               {ZES_ENGINE_TYPE_FLAG_COMPUTE, "compute"},
+               {ZES_ENGINE_TYPE_FLAG_3D, "3d"},
+               {ZES_ENGINE_TYPE_FLAG_MEDIA, "media"},
+               {ZES_ENGINE_TYPE_FLAG_DMA, "dma"},
+               {ZES_ENGINE_TYPE_FLAG_RENDER, "render"}};
+  std::string result;
+
+  for (const auto &name : names) {
+    if (engines & name.first) {
+      result += (result.empty() ? "" : ",") + name.second;
+    }
+  }
+  return result.empty() ? "none" : result;
+}
+
+// A point is on the Pareto front when no other point delivers at least the
+// same throughput for at most the same power.
+static void mark_pareto(std::vector<factor_point_t> &points) {
+  for (factor_point_t &point : points) {
+    point.pareto = true;
+    for (const factor_point_t &other : points) {
+      if (other.throughput >= point.throughput &&
+          other.watts <= point.watts &&
+          (other.throughput > point.throughput ||
+           other.watts < point.watts)) {
+        point.pareto = false;
+        break;
+      }
+    }
+  }
+}
+
+// Launches the list back to back for sample_msec and reads the energy
+// counter around it. A failed call ends the measurement with its result.
+ze_result_t ZeSysmanPerf::measure_factor(zes_pwr_handle_t power,
+                                         ze_command_list_handle_t list,
+                                         long double work_per_launch,
+                                         factor_point_t &point) {
+  zes_power_energy_counter_t energy_start = {};
+  zes_power_energy_counter_t energy_end = {};
+  uint64_t launches = 0;
+  long double usec = 0;
+
+  ze_result_t result = try_launch(list, usec);
+  if (result != ZE_RESULT_SUCCESS) {
+    return result;
+  }
+  time_point_t origin = std::chrono::steady_clock::now();
+  result = zesPowerGetEnergyCounter(power, &energy_start);
+  while (result == ZE_RESULT_SUCCESS &&
+         usec_since(origin) < sample_msec * 1000.0L) {
+    result = try_launch(list, usec);
+    launches++;
+  }
+  if (result == ZE_RESULT_SUCCESS) {
+    result = zesPowerGetEnergyCounter(power, &energy_end);
+  }
+  if (result != ZE_RESULT_SUCCESS) {
+    return result;
+  }
+  usec = usec_since(origin);
+
+  point.throughput = work_per_launch * launches / usec / 1000.0L;
+  point.watts = watts(energy_start, energy_end);
+  return ZE_RESULT_SUCCESS;
+}
+
+// Measures both workloads at every factor from 0 to 100 in steps of
+// factor_step, 100 included, and stops at the first failed call. The
+// caller restores the original factor.
+ze_result_t ZeSysmanPerf::sweep_factor(zes_perf_handle_t domain,
+                                       zes_pwr_handle_t power,
+                                       std::vector<factor_point_t> &compute,
+                                       std::vector<factor_point_t> &stream) {
+  // Two multiply-adds of two flops each per loop iteration and work-item.
+  const long double compute_work = 4.0L * work_items * compute_iterations;
+  std::vector<uint32_t> factors;
+  for (uint32_t factor = 0U; factor < 100; factor += factor_step) {
+    factors.push_back(factor);
+  }
+  factors.push_back(100);
+
+  for (uint32_t factor : factors) {
+    factor_point_t compute_point = {};
+    factor_point_t stream_point = {};
+    compute_point.factor = stream_point.factor = factor;
+    ze_result_t result = zesPerformanceFactorSetConfig(domain, factor);
+    if (result == ZE_RESULT_SUCCESS) {
+      result = measure_factor(power, compute_list, compute_work,
+                              compute_point);
+    }
+    if (result == ZE_RESULT_SUCCESS) {
+      result = measure_factor(power, stream_list, stream_bytes, stream_point);
+    }
+    if (result != ZE_RESULT_SUCCESS) {
+      return result;
+    }
+    compute.push_back(compute_point);
+    stream.push_back(stream_point);
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+void ZeSysmanPerf::report_factor(uint32_t domain, const std::string &engines,
+                                 const std::string &workload,
+                                 const std::vector<factor_point_t> &points,
+                                 bool complete) {
+  const char *unit = workload == "compute" ? "Gflops" : "GB/s";
+
+  for (const factor_point_t &point : points) {
+    std::cout << "[domain " << domain << " " << engines << "][" << std::left
+              << std::setw(7) << workload << std::right << "][factor "
+              << std::fixed << std::setprecision(0) << std::setw(3)
+              << point.factor << "]:  " << std::setprecision(2)
+              << std::setw(9) << point.throughput << " " << std::left
+              << std::setw(6) << unit << std::right << std::setw(8)
+              << point.watts << " W  " << std::setw(7)
+              << (point.watts > 0 ? point.throughput / point.watts : 0)
+              << " " << unit << "/W" << (point.pareto ? "  pareto" : "")
+              << (complete ? "" : "  incomplete sweep") << std::endl;
+
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "Performance factor");
+        test_ptree.put("Domain", domain);
+        test_ptree.put("Engines", engines);
+        test_ptree.put("Workload", workload);
+        test_ptree.put("Factor", point.factor);
+        test_ptree.put(std::string("Throughput(") + unit + ")",
+                       point.throughput);
+        test_ptree.put("Power(W)", point.watts);
+        test_ptree.put("Pareto", point.pareto);
+        test_ptree.put("Complete sweep", complete);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting performance factor measurement: "
+                  << e.what() << std::endl;
+      }
+    }
+  }
+}
+
+void ZeSysmanPerf::performance_factor(void) {
+  uint32_t count = 0;
+
+  std::cout << "Performance factor sweep" << std::endl;
+  zes_pwr_handle_t power = power_domain(0);
+  if (power == nullptr) {
+    std::cout << "power measurement not supported" << std::endl;
+    return;
+  }
+  SUCCESS_OR_TERMINATE(zesDeviceEnumPerformanceFactorDomains(
+      sysman_devices[0], &count, nullptr));
+  std::vector<zes_perf_handle_t> domains(count);
+  SUCCESS_OR_TERMINATE(zesDeviceEnumPerformanceFactorDomains(
+      sysman_devices[0], &count, domains.data()));
+  if (count == 0) {
+    std::cout << "performance factor domains not supported" << std::endl;
+    return;
+  }
+
+  create_stream();
+
+  for (uint32_t d = 0U; d < count; d++) {
+    zes_perf_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_PERF_PROPERTIES;
+    SUCCESS_OR_TERMINATE(
+        zesPerformanceFactorGetProperties(domains[d], &properties));
+    std::string engines = engine_names(properties.engines);
+
+    double original = 0;
+    SUCCESS_OR_TERMINATE(zesPerformanceFactorGetConfig(domains[d], &original));
+
+    std::vector<factor_point_t> compute_points;
+    std::vector<factor_point_t> stream_points;
+    ze_result_t result = ZE_RESULT_SUCCESS;
+    {
+      restore_guard_t restore([&]() {
+        SUCCESS_OR_WARN(zesPerformanceFactorSetConfig(domains[d], original));
+      });
+      result =
+          sweep_factor(domains[d], power, compute_points, stream_points);
+    }
+
+    if (compute_points.empty()) {
+      std::cout << "[domain " << d << " " << engines << "]:  not supported"
+                << std::endl;
+      if (diagnostics) {
+        std::cerr << "WARNING : performance factor sweep : " << result
+                  << std::endl;
+      }
+      continue;
+    }
+    // Points of a sweep cut short are reported, marked as incomplete, but
+    // their Pareto front only covers the factors reached.
+    const bool complete = result == ZE_RESULT_SUCCESS;
+    if (!complete) {
+      std::cerr << "ERROR : performance factor sweep of domain " << d
+                << " stopped, original factor restored : " << result
+                << std::endl;
+    }
+    mark_pareto(compute_points);
+    mark_pareto(stream_points);
+    report_factor(d, engines, "compute", compute_points, complete);
+    report_factor(d, engines, "memory", stream_points, complete);
+  }
+
+  destroy_stream();
+}
@@ -0,0 +1,316 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+struct scheduler_state_t {
+  zes_sched_handle_t handle;
+  zes_sched_mode_t mode;
+  zes_sched_timeout_properties_t timeout;
+  zes_sched_timeslice_properties_t timeslice;
+};
+
+static std::string mode_name(const scheduler_config_t &config) {
+  if (!config.change) {
+    return "current";
+  }
+  switch (config.mode) {
+  case ZES_SCHED_MODE_TIMEOUT:
+    return "timeout " + std::to_string(config.value_usec) + " usec";
+  case ZES_SCHED_MODE_TIMESLICE:
+    return "timeslice " + std::to_string(config.value_usec) + " usec";
+  default:
+    return "exclusive";
+  }
+}
+
+static ze_result_t set_timeout(zes_sched_handle_t scheduler,
+                               zes_sched_timeout_properties_t properties,
+                               ze_bool_t *reload) {
+  properties.stype = ZES_STRUCTURE_TYPE_SCHED_TIMEOUT_PROPERTIES;
+  properties.pNext = nullptr;
+  return zesSchedulerSetTimeoutMode(scheduler, &properties, reload);
+}
+
+static ze_result_t set_timeslice(zes_sched_handle_t scheduler,
+                                 zes_sched_timeslice_properties_t properties,
+                                 ze_bool_t *reload) {
+  properties.stype = ZES_STRUCTURE_TYPE_SCHED_TIMESLICE_PROPERTIES;
+  properties.pNext = nullptr;
+  return zesSchedulerSetTimesliceMode(scheduler, &properties, reload);
+}
+
+static ze_result_t set_mode(const scheduler_state_t &state,
+                            ze_bool_t *reload) {
+  switch (state.mode) {
+  case ZES_SCHED_MODE_TIMEOUT:
+    return set_timeout(state.handle, state.timeout, reload);
+  case ZES_SCHED_MODE_TIMESLICE:
+    return set_timeslice(state.handle, state.timeslice, reload);
+  case ZES_SCHED_MODE_EXCLUSIVE:
+    return zesSchedulerSetExclusiveMode(state.handle, reload);
+  default:
+    return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+}
+
+static std::string read_output(FILE *pipe) {
+  std::string output;
+  char buffer[256];
+
+  while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+    output += buffer;
+  }
+  return output;
+}
+
+// Worker process side: wait for the common start time, then run for
+// sample_msec and print the result on a single line for the parent.
+void ZeSysmanPerf::run_worker(void) {
+  std::chrono::system_clock::time_point start{
+      std::chrono::milliseconds(window_start)};
+  if (std::chrono::system_clock::now() > start) {
+    std::cerr << "WARNING : " << worker << " worker started late" << std::endl;
+  }
+  std::this_thread::sleep_until(start);
+
+  time_point_t origin = std::chrono::steady_clock::now();
+  const long double window_usec = sample_msec * 1000.0L;
+  if (worker == "latency") {
+    std::vector<long double> latencies;
+    while (usec_since(origin) < window_usec) {
+      latencies.push_back(launch(compute_list));
+      std::this_thread::sleep_for(std::chrono::microseconds(poll_usec));
+    }
+    std::cout << percentile(latencies, 0.5) << " "
+              << percentile(latencies, 0.99) << " " << latencies.size()
+              << std::endl;
+  } else {
+    uint64_t launches = 0;
+    while (usec_since(origin) < window_usec) {
+      launch(compute_list);
+      launches++;
+    }
+    long double usec = usec_since(origin);
+    std::cout << launches << " " << usec << " "
+              << 4.0L * work_items * compute_iterations * launches / usec /
+                     1000.0L
+              << std::endl;
+  }
+}
+
+// Starts a throughput process with long kernels and a latency process with
+// short kernels, both measuring over the same wall clock window.
+scheduler_result_t ZeSysmanPerf::measure_scheduler(void) {
+  scheduler_result_t result;
+
+  uint64_t start =
+      static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::system_clock::now().time_since_epoch())
+              .count()) +
+      worker_start_msec;
+  std::string arguments = " --work-items " + std::to_string(work_items) +
+                          " --sample-msec " + std::to_string(sample_msec) +
+                          " --poll-usec " + std::to_string(poll_usec) +
+                          " --window-start " + std::to_string(start);
+  std::string throughput_command =
+      "\"" + executable + "\" --worker throughput --kernel-usec " +
+      std::to_string(long_kernel_usec) + arguments;
+  std::string latency_command = "\"" + executable +
+                                "\" --worker latency --latency-iter " +
+                                std::to_string(latency_iterations) +
+                                arguments;
+
+  FILE *throughput_pipe = popen(throughput_command.c_str(), "r");
+  FILE *latency_pipe = popen(latency_command.c_str(), "r");
+  if (throughput_pipe == nullptr || latency_pipe == nullptr) {
+    std::cerr << "Error starting worker processes" << std::endl;
+    if (throughput_pipe != nullptr) {
+      pclose(throughput_pipe);
+    }
+    if (latency_pipe != nullptr) {
+      pclose(latency_pipe);
+    }
+    result.worker_failed = true;
+    return result;
+  }
+  std::istringstream latency_output(read_output(latency_pipe));
+  std::istringstream throughput_output(read_output(throughput_pipe));
+  int latency_status = pclose(latency_pipe);
+  int throughput_status = pclose(throughput_pipe);
+
+  long double throughput_usec = 0;
+  latency_output >> result.p50_usec >> result.p99_usec >>
+      result.latency_launches;
+  throughput_output >> result.throughput_launches >> throughput_usec >>
+      result.gflops;
+  if (latency_status != 0 || throughput_status != 0 || latency_output.fail() ||
+      throughput_output.fail() || throughput_usec <= 0) {
+    std::cerr << "Error reading worker process results, exit status "
+              << latency_status << " (latency) and " << throughput_status
+              << " (throughput)" << std::endl;
+    result.worker_failed = true;
+    return result;
+  }
+  result.launches_per_sec =
+      result.throughput_launches * 1000000.0L / throughput_usec;
+  result.valid = true;
+  return result;
+}
+
+void ZeSysmanPerf::report_scheduler(const scheduler_config_t &config,
+                                    const scheduler_result_t &result) {
+  std::cout << "[" << std::left << std::setw(24) << mode_name(config)
+            << std::right << "]:";
+  if (result.worker_failed) {
+    std::cout << "  ERROR : worker process failed" << std::endl;
+    return;
+  }
+  if (!result.valid) {
+    std::cout << "  not supported" << std::endl;
+    return;
+  }
+  std::cout << "  latency p50 = " << std::fixed << std::setprecision(1)
+            << std::setw(9) << result.p50_usec
+            << " usec  p99 = " << std::setw(9) << result.p99_usec
+            << " usec  throughput = " << std::setprecision(2) << std::setw(9)
+            << result.gflops << " Gflops  " << std::setw(7)
+            << result.launches_per_sec << " launches/s" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Scheduler mode");
+      test_ptree.put("Mode", mode_name(config));
+      test_ptree.put("Latency p50(usec)", result.p50_usec);
+      test_ptree.put("Latency p99(usec)", result.p99_usec);
+      test_ptree.put("Latency launches", result.latency_launches);
+      test_ptree.put("Throughput(Gflops)", result.gflops);
+      test_ptree.put("Throughput launches", result.throughput_launches);
+      test_ptree.put("Throughput(launches/s)", result.launches_per_sec);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting scheduler mode measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void ZeSysmanPerf::scheduler_mode(void) {
+  uint32_t count = 0;
+  std::vector<scheduler_state_t> schedulers;
+
+  std::cout << "Scheduler mode impact on a latency process next to a "
+               "throughput process"
+            << std::endl;
+  report_scheduler({false, ZES_SCHED_MODE_TIMEOUT, 0}, measure_scheduler());
+
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumSchedulers(sysman_devices[0], &count, nullptr));
+  std::vector<zes_sched_handle_t> handles(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumSchedulers(sysman_devices[0], &count, handles.data()));
+
+  // Only schedulers of compute engines affect the two processes.
+  zes_sched_supported_mode_flags_t supported_modes = ~0U;
+  for (zes_sched_handle_t handle : handles) {
+    zes_sched_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_SCHED_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesSchedulerGetProperties(handle, &properties));
+    if (!properties.canControl ||
+        !(properties.engines &
+          (ZES_ENGINE_TYPE_FLAG_COMPUTE | ZES_ENGINE_TYPE_FLAG_RENDER))) {
+      continue;
+    }
+    supported_modes &= properties.supportedModes;
+
+    scheduler_state_t state = {};
+    state.handle = handle;
+    state.timeout.stype = ZES_STRUCTURE_TYPE_SCHED_TIMEOUT_PROPERTIES;
+    state.timeslice.stype = ZES_STRUCTURE_TYPE_SCHED_TIMESLICE_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesSchedulerGetCurrentMode(handle, &state.mode));
+    if (zesSchedulerGetTimeoutModeProperties(handle, false, &state.timeout) !=
+        ZE_RESULT_SUCCESS) {
+      SUCCESS_OR_TERMINATE(
+          zesSchedulerGetTimeoutModeProperties(handle, true, &state.timeout));
+    }
+    if (zesSchedulerGetTimesliceModeProperties(
+            handle, false, &state.timeslice) != ZE_RESULT_SUCCESS) {
+      SUCCESS_OR_TERMINATE(zesSchedulerGetTimesliceModeProperties(
+          handle, true, &state.timeslice));
+    }
+    schedulers.push_back(state);
+  }
+  if (schedulers.empty()) {
+    std::cout << "scheduler control not supported" << std::endl;
+    return;
+  }
+
+  // Puts back the modes found at the start on every path out of the test.
+  // A mode set_mode cannot apply, such as the debug mode, is left as the
+  // last one measured, with a warning.
+  restore_guard_t restore([&]() {
+    for (const scheduler_state_t &original : schedulers) {
+      ze_bool_t reload = false;
+      if (original.mode != ZES_SCHED_MODE_TIMEOUT &&
+          original.mode != ZES_SCHED_MODE_TIMESLICE &&
+          original.mode != ZES_SCHED_MODE_EXCLUSIVE) {
+        std::cerr << "WARNING : original scheduler mode " << original.mode
+                  << " cannot be restored" << std::endl;
+        continue;
+      }
+      SUCCESS_OR_WARN(set_mode(original, &reload));
+    }
+  });
+
+  std::vector<scheduler_config_t> configs;
+  for (uint32_t value : timeout_values) {
+    configs.push_back({true, ZES_SCHED_MODE_TIMEOUT, value});
+  }
+  for (uint32_t value : timeslice_values) {
+    configs.push_back({true, ZES_SCHED_MODE_TIMESLICE, value});
+  }
+  configs.push_back({true, ZES_SCHED_MODE_EXCLUSIVE, 0});
+
+  for (const scheduler_config_t &config : configs) {
+    if (!(supported_modes & (1U << config.mode))) {
+      report_scheduler(config, scheduler_result_t());
+      continue;
+    }
+
+    bool applied = true;
+    for (const scheduler_state_t &original : schedulers) {
+      scheduler_state_t state = original;
+      ze_bool_t reload = false;
+      state.mode = config.mode;
+      state.timeout.watchdogTimeout = config.value_usec;
+      state.timeslice.interval = config.value_usec;
+      ze_result_t result = set_mode(state, &reload);
+      if (result != ZE_RESULT_SUCCESS || reload) {
+        if (diagnostics) {
+          std::cerr << "WARNING : scheduler mode " << mode_name(config)
+                    << " : " << result << (reload ? ", needs reload" : "")
+                    << std::endl;
+        }
+        applied = false;
+        break;
+      }
+    }
+    report_scheduler(config,
+                     applied ? measure_scheduler() : scheduler_result_t());
+  }
+}
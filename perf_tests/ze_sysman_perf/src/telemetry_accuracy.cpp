@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Work done by the launches within [start, end), a launch overlapping the
+// boundaries contributes in proportion to its overlap. Without a work amount
+// per launch, the busy time is returned.
+static long double work_between(const std::vector<timed_sample_t> &launches,
+                                long double start, long double end,
+                                long double work_per_launch) {
+  long double work = 0;
+
+  for (const timed_sample_t &launch : launches) {
+    long double launch_end = launch.usec;
+    long double launch_start = launch_end - launch.value;
+    long double overlap =
+        std::min(launch_end, end) - std::max(launch_start, start);
+    if (overlap <= 0 || launch.value <= 0) {
+      continue;
+    }
+    work += work_per_launch > 0 ? work_per_launch * overlap / launch.value
+                                : overlap;
+  }
+  return work;
+}
+
+// The workload runs in the background while the counter is read every
+// interval. The counter rate over each interval, based on the counter
+// timestamps, is compared with the rate of the work actually done over the
+// same interval.
+void ZeSysmanPerf::telemetry_case(const telemetry_case_t &test_case) {
+  for (uint32_t interval_msec : telemetry_intervals) {
+    const uint32_t samples = std::max(3U, sample_msec / interval_msec);
+    std::vector<timed_sample_t> launches;
+    std::vector<std::pair<long double, counter_reading_t>> readings;
+    std::atomic<bool> stop(false);
+    bool supported = true;
+
+    time_point_t origin = std::chrono::steady_clock::now();
+    std::thread workload(&ZeSysmanPerf::run_until, this, test_case.list,
+                         test_case.duty_cycle, std::cref(stop), origin,
+                         std::ref(launches));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    time_point_t next = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i <= samples; i++) {
+      counter_reading_t reading = {};
+      if (!test_case.read(reading)) {
+        supported = false;
+        break;
+      }
+      readings.push_back({usec_since(origin), reading});
+      next += std::chrono::milliseconds(interval_msec);
+      std::this_thread::sleep_until(next);
+    }
+    stop = true;
+    workload.join();
+    SUCCESS_OR_TERMINATE(workload_result.load());
+
+    std::cout << "[" << std::left << std::setw(23) << test_case.name
+              << std::right << "][interval " << std::setw(5) << interval_msec
+              << " msec]:";
+    if (!supported) {
+      std::cout << "  not supported" << std::endl;
+      return;
+    }
+
+    long double truth_sum = 0;
+    long double counter_sum = 0;
+    long double error_sum = 0;
+    long double error_max = 0;
+    for (size_t i = 1U; i < readings.size(); i++) {
+      const counter_reading_t &first = readings[i - 1].second;
+      const counter_reading_t &last = readings[i].second;
+      long double host_usec = readings[i].first - readings[i - 1].first;
+      long double truth =
+          work_between(launches, readings[i - 1].first, readings[i].first,
+                       test_case.work_per_launch) /
+          host_usec * test_case.scale;
+      long double counter =
+          last.timestamp > first.timestamp
+              ? static_cast<long double>(last.value - first.value) /
+                    static_cast<long double>(last.timestamp -
+                                             first.timestamp) *
+                    test_case.scale
+              : 0;
+      long double error = truth > 0 ? (counter - truth) / truth * 100 : 0;
+      truth_sum += truth;
+      counter_sum += counter;
+      error_sum += std::fabs(error);
+      error_max = std::max(error_max, std::fabs(error));
+    }
+    const size_t intervals = readings.size() - 1;
+    long double truth_mean = truth_sum / intervals;
+    long double counter_mean = counter_sum / intervals;
+    long double error_mean = error_sum / intervals;
+
+    std::cout << "  measured = " << std::fixed << std::setprecision(2)
+              << std::setw(8) << truth_mean << " " << test_case.unit
+              << "  counter = " << std::setw(8) << counter_mean << " "
+              << test_case.unit << "  error mean = " << std::setw(7)
+              << error_mean << " %  max = " << std::setw(7) << error_max
+              << " %" << std::endl;
+
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "Telemetry accuracy");
+        test_ptree.put("Counter", test_case.name);
+        test_ptree.put("Interval(msec)", interval_msec);
+        test_ptree.put("Intervals", intervals);
+        test_ptree.put(std::string("Measured(") + test_case.unit + ")",
+                       truth_mean);
+        test_ptree.put(std::string("Counter(") + test_case.unit + ")",
+                       counter_mean);
+        test_ptree.put("Error mean(%)", error_mean);
+        test_ptree.put("Error max(%)", error_max);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting telemetry accuracy measurement: "
+                  << e.what() << std::endl;
+      }
+    }
+  }
+}
+
+void ZeSysmanPerf::telemetry_accuracy(void) {
+  zes_device_handle_t device = sysman_devices[0];
+  ze_command_list_handle_t to_device_list = nullptr;
+  ze_command_list_handle_t from_device_list = nullptr;
+  void *host_buffer = nullptr;
+  uint32_t count = 0;
+
+  std::cout << "Telemetry counters against measured workloads" << std::endl;
+  create_stream();
+  benchmark->memoryAllocHost(stream_size, &host_buffer);
+  benchmark->commandListCreate(0, compute_ordinal, &to_device_list);
+  benchmark->commandListAppendMemoryCopy(to_device_list, stream_src,
+                                         host_buffer, stream_size);
+  benchmark->commandListClose(to_device_list);
+  benchmark->commandListCreate(0, compute_ordinal, &from_device_list);
+  benchmark->commandListAppendMemoryCopy(from_device_list, host_buffer,
+                                         stream_dst, stream_size);
+  benchmark->commandListClose(from_device_list);
+
+  // Memory bandwidth: read and write counters of all memory modules while
+  // the stream kernel runs back to back.
+  SUCCESS_OR_TERMINATE(zesDeviceEnumMemoryModules(device, &count, nullptr));
+  std::vector<zes_mem_handle_t> modules(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumMemoryModules(device, &count, modules.data()));
+  telemetry_case({"memory bandwidth", stream_list, 1.0, stream_bytes,
+                  [&modules](counter_reading_t &reading) {
+                    for (zes_mem_handle_t module : modules) {
+                      zes_mem_bandwidth_t bandwidth = {};
+                      if (zesMemoryGetBandwidth(module, &bandwidth) !=
+                          ZE_RESULT_SUCCESS) {
+                        return false;
+                      }
+                      reading.value +=
+                          bandwidth.readCounter + bandwidth.writeCounter;
+                      reading.timestamp = bandwidth.timestamp;
+                    }
+                    return !modules.empty();
+                  },
+                  "GB/s", 1e-3L});
+
+  // Engine utilization: active time of the compute engine group while the
+  // compute kernel runs at a known duty cycle.
+  zes_engine_handle_t engine = nullptr;
+  SUCCESS_OR_TERMINATE(zesDeviceEnumEngineGroups(device, &count, nullptr));
+  std::vector<zes_engine_handle_t> engines(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumEngineGroups(device, &count, engines.data()));
+  for (zes_engine_handle_t handle : engines) {
+    zes_engine_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_ENGINE_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesEngineGetProperties(handle, &properties));
+    if (!properties.onSubdevice &&
+        (properties.type == ZES_ENGINE_GROUP_COMPUTE_ALL ||
+         (properties.type == ZES_ENGINE_GROUP_ALL && engine == nullptr))) {
+      engine = handle;
+    }
+  }
+  for (uint32_t duty_cycle : duty_cycles) {
+    telemetry_case({"engine utilization " + std::to_string(duty_cycle) + "%",
+                    compute_list, duty_cycle / 100.0, 0,
+                    [engine](counter_reading_t &reading) {
+                      zes_engine_stats_t stats = {};
+                      if (engine == nullptr ||
+                          zesEngineGetActivity(engine, &stats) !=
+                              ZE_RESULT_SUCCESS) {
+                        return false;
+                      }
+                      reading.value = stats.activeTime;
+                      reading.timestamp = stats.timestamp;
+                      return true;
+                    },
+                    "%", 100.0L});
+  }
+
+  // PCI throughput: received bytes while copying to the device and
+  // transmitted bytes while copying from it.
+  auto pci_reader = [device](bool received) {
+    return [device, received](counter_reading_t &reading) {
+      zes_pci_stats_t stats = {};
+      if (zesDevicePciGetStats(device, &stats) != ZE_RESULT_SUCCESS) {
+        return false;
+      }
+      reading.value = received ? stats.rxCounter : stats.txCounter;
+      reading.timestamp = stats.timestamp;
+      return true;
+    };
+  };
+  const long double copy_bytes = static_cast<long double>(stream_size);
+  telemetry_case({"pci rx", to_device_list, 1.0, copy_bytes, pci_reader(true),
+                  "GB/s", 1e-3L});
+  telemetry_case({"pci tx", from_device_list, 1.0, copy_bytes,
+                  pci_reader(false), "GB/s", 1e-3L});
+
+  benchmark->commandListDestroy(to_device_list);
+  benchmark->commandListDestroy(from_device_list);
+  benchmark->memoryFree(host_buffer);
+  destroy_stream();
+}
@@ -0,0 +1,246 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+
+// Throttling has set in once throughput stays this far below its peak, and
+// the sustained level is reached once it stays this close to its final
+// value.
+static const double soak_band = 0.05;
+
+static std::string throttle_names(zes_freq_throttle_reason_flags_t reasons) {
+  static const std::vector<
+      std::pair<zes_freq_throttle_reason_flags_t, std::string>>
+      names = {{ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP, "avg_pwr"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_BURST_PWR_CAP, "burst_pwr"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_CURRENT_LIMIT, "current"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_THERMAL_LIMIT, "thermal"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_PSU_ALERT, "psu"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_SW_RANGE, "sw_range"},
+               {ZES_FREQ_THROTTLE_REASON_FLAG_HW_RANGE, "hw_range"}};
+  std::string result;
+
+  for (const auto &name : names) {
+    if (reasons & name.first) {
+      result += (result.empty() ? "" : ",") + name.second;
+    }
+  }
+  return result.empty() ? "none" : result;
+}
+
+// The GPU sensor if there is one, otherwise the global sensor.
+static zes_temp_handle_t temperature_sensor(zes_device_handle_t device) {
+  zes_temp_handle_t sensor = nullptr;
+  uint32_t count = 0;
+
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumTemperatureSensors(device, &count, nullptr));
+  std::vector<zes_temp_handle_t> sensors(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumTemperatureSensors(device, &count, sensors.data()));
+  for (zes_temp_handle_t handle : sensors) {
+    zes_temp_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_TEMP_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesTemperatureGetProperties(handle, &properties));
+    if (properties.onSubdevice) {
+      continue;
+    }
+    if (properties.type == ZES_TEMP_SENSORS_GPU ||
+        (properties.type == ZES_TEMP_SENSORS_GLOBAL && sensor == nullptr)) {
+      sensor = handle;
+    }
+  }
+  return sensor;
+}
+
+// Reads every sysman value of one soak sample. Values which cannot be read
+// are left at zero.
+static void read_soak_state(zes_freq_handle_t freq, zes_temp_handle_t sensor,
+                            zes_fan_handle_t fan, soak_sample_t &sample) {
+  if (freq != nullptr) {
+    zes_freq_state_t state = {};
+    state.stype = ZES_STRUCTURE_TYPE_FREQ_STATE;
+    if (zesFrequencyGetState(freq, &state) == ZE_RESULT_SUCCESS) {
+      sample.mhz = state.actual;
+      sample.throttle = state.throttleReasons;
+    }
+  }
+  if (sensor != nullptr) {
+    zesTemperatureGetState(sensor, &sample.celsius);
+  }
+  if (fan != nullptr) {
+    zesFanGetState(fan, ZES_FAN_SPEED_UNITS_RPM, &sample.fan_rpm);
+  }
+}
+
+void ZeSysmanPerf::report_soak_sample(const soak_sample_t &sample) {
+  std::cout << "[" << std::fixed << std::setprecision(1) << std::setw(8)
+            << sample.usec / 1000000.0L << " s]:  " << std::setprecision(2)
+            << std::setw(9) << sample.gflops << " Gflops  " << std::setw(7)
+            << sample.watts << " W  " << std::setprecision(1) << std::setw(5)
+            << sample.celsius << " C  " << std::setprecision(0)
+            << std::setw(5) << sample.mhz << " MHz  " << std::setw(5)
+            << sample.fan_rpm << " rpm  " << throttle_names(sample.throttle)
+            << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Thermal soak sample");
+      test_ptree.put("Time(sec)", sample.usec / 1000000.0L);
+      test_ptree.put("Throughput(Gflops)", sample.gflops);
+      test_ptree.put("Power(W)", sample.watts);
+      test_ptree.put("Temperature(C)", sample.celsius);
+      test_ptree.put("Frequency(MHz)", sample.mhz);
+      test_ptree.put("Fan(rpm)", sample.fan_rpm);
+      test_ptree.put("Throttle reasons", throttle_names(sample.throttle));
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting thermal soak sample: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// The peak is the best sample, the sustained throughput the median of the
+// last quarter of the run. Throttling onset is the first sample reporting a
+// throttle reason and the first sample below the peak by more than the
+// band, and the sustained level is reached at the first sample after which
+// throughput stays within the band of it.
+void ZeSysmanPerf::report_soak(const std::vector<soak_sample_t> &samples) {
+  if (samples.empty()) {
+    return;
+  }
+  std::vector<timed_sample_t> throughput;
+  std::vector<long double> tail;
+  long double peak = 0;
+  long double reason_onset = -1;
+  long double drop_onset = -1;
+  for (const soak_sample_t &sample : samples) {
+    throughput.push_back({sample.usec, static_cast<double>(sample.gflops)});
+    peak = std::max(peak, sample.gflops);
+    if (reason_onset < 0 && sample.throttle != 0) {
+      reason_onset = sample.usec;
+    }
+  }
+  for (size_t i = samples.size() - (samples.size() + 3) / 4;
+       i < samples.size(); i++) {
+    tail.push_back(samples[i].gflops);
+  }
+  for (const soak_sample_t &sample : samples) {
+    if (sample.gflops < peak * (1 - soak_band)) {
+      drop_onset = sample.usec;
+      break;
+    }
+  }
+  long double sustained = median(tail);
+  int index = settled_index(throughput, static_cast<double>(sustained),
+                            soak_band * static_cast<double>(sustained));
+  long double steady =
+      index >= 0 ? throughput[static_cast<size_t>(index)].usec : -1;
+
+  // Onsets which never happened are reported as -1.
+  reason_onset = reason_onset < 0 ? -1 : reason_onset / 1000000.0L;
+  drop_onset = drop_onset < 0 ? -1 : drop_onset / 1000000.0L;
+  steady = steady < 0 ? -1 : steady / 1000000.0L;
+  auto seconds = [](long double sec) {
+    return sec < 0 ? std::string("never")
+                   : std::to_string(static_cast<int>(sec)) + " s";
+  };
+  std::cout << "peak = " << std::fixed << std::setprecision(2) << peak
+            << " Gflops  sustained = " << sustained << " Gflops ("
+            << std::setprecision(1)
+            << (peak > 0 ? sustained * 100 / peak : 0) << " %)" << std::endl;
+  std::cout << "throttle reason from " << seconds(reason_onset)
+            << "  throughput drop from " << seconds(drop_onset)
+            << "  sustained from " << seconds(steady) << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Thermal soak");
+      test_ptree.put("Duration(sec)", samples.back().usec / 1000000.0L);
+      test_ptree.put("Peak(Gflops)", peak);
+      test_ptree.put("Sustained(Gflops)", sustained);
+      test_ptree.put("Throttle reason onset(sec)", reason_onset);
+      test_ptree.put("Throughput drop onset(sec)", drop_onset);
+      test_ptree.put("Sustained from(sec)", steady);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting thermal soak measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// compute_loop runs back to back for soak_sec. Every sample_msec the
+// throughput of the launches completed since the previous sample is
+// recorded together with the power, temperature, frequency, throttle
+// reasons and fan speed.
+void ZeSysmanPerf::thermal_soak(void) {
+  zes_device_handle_t device = sysman_devices[0];
+  uint32_t count = 0;
+
+  std::cout << "Thermal soak of " << soak_sec << " seconds" << std::endl;
+  zes_freq_handle_t freq = nullptr;
+  SUCCESS_OR_TERMINATE(zesDeviceEnumFrequencyDomains(device, &count, nullptr));
+  std::vector<zes_freq_handle_t> freq_domains(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumFrequencyDomains(device, &count, freq_domains.data()));
+  for (zes_freq_handle_t handle : freq_domains) {
+    zes_freq_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_FREQ_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesFrequencyGetProperties(handle, &properties));
+    if (properties.type == ZES_FREQ_DOMAIN_GPU && freq == nullptr) {
+      freq = handle;
+    }
+  }
+  zes_temp_handle_t sensor = temperature_sensor(device);
+  zes_fan_handle_t fan = nullptr;
+  count = 1;
+  if (zesDeviceEnumFans(device, &count, &fan) != ZE_RESULT_SUCCESS) {
+    fan = nullptr;
+  }
+  zes_pwr_handle_t power = power_domain(0);
+
+  // Two multiply-adds of two flops each per loop iteration and work-item.
+  const long double work = 4.0L * work_items * compute_iterations;
+  std::vector<soak_sample_t> samples;
+  zes_power_energy_counter_t energy_start = {};
+  zes_power_energy_counter_t energy_end = {};
+  if (power != nullptr) {
+    SUCCESS_OR_TERMINATE(zesPowerGetEnergyCounter(power, &energy_start));
+  }
+  time_point_t origin = std::chrono::steady_clock::now();
+  long double sample_start = 0;
+  for (uint64_t s = 1U; s * sample_msec <= soak_sec * 1000ULL; s++) {
+    const long double sample_end = s * sample_msec * 1000.0L;
+    uint64_t launches = 0;
+    while (usec_since(origin) < sample_end) {
+      launch(compute_list);
+      launches++;
+    }
+
+    soak_sample_t sample;
+    sample.usec = usec_since(origin);
+    sample.gflops = work * launches / (sample.usec - sample_start) / 1000.0L;
+    if (power != nullptr) {
+      SUCCESS_OR_TERMINATE(zesPowerGetEnergyCounter(power, &energy_end));
+      sample.watts = watts(energy_start, energy_end);
+      energy_start = energy_end;
+    }
+    read_soak_state(freq, sensor, fan, sample);
+    report_soak_sample(sample);
+    samples.push_back(sample);
+    sample_start = usec_since(origin);
+  }
+
+  report_soak(samples);
+}
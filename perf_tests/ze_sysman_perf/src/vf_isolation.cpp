@@ -0,0 +1,345 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+struct vf_state_t {
+  zes_vf_handle_t handle;
+  uint32_t id;
+  std::vector<zes_vf_util_engine_exp2_t> bin_start;
+  std::vector<zes_vf_util_engine_exp2_t> last;
+  std::vector<double> peak;         /* per engine group over the bin */
+  std::vector<long double> busiest; /* per bin, busiest engine group */
+};
+
+static std::string group_name(zes_engine_group_t group) {
+  switch (group) {
+  case ZES_ENGINE_GROUP_ALL:
+    return "all";
+  case ZES_ENGINE_GROUP_COMPUTE_ALL:
+    return "compute";
+  case ZES_ENGINE_GROUP_MEDIA_ALL:
+    return "media";
+  case ZES_ENGINE_GROUP_COPY_ALL:
+    return "copy";
+  default:
+    return "group " + std::to_string(static_cast<int>(group));
+  }
+}
+
+static uint64_t epoch_msec(void) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+}
+
+static bool read_engines(zes_vf_handle_t vf,
+                         std::vector<zes_vf_util_engine_exp2_t> &engines) {
+  uint32_t count = 0;
+  if (zesVFManagementGetVFEngineUtilizationExp2(vf, &count, nullptr) !=
+      ZE_RESULT_SUCCESS) {
+    return false;
+  }
+  engines.assign(count, zes_vf_util_engine_exp2_t{});
+  for (zes_vf_util_engine_exp2_t &engine : engines) {
+    engine.stype = ZES_STRUCTURE_TYPE_VF_UTIL_ENGINE_EXP2;
+  }
+  return zesVFManagementGetVFEngineUtilizationExp2(vf, &count,
+                                                   engines.data()) ==
+         ZE_RESULT_SUCCESS;
+}
+
+static uint64_t read_memory(zes_vf_handle_t vf) {
+  uint32_t count = 0;
+  uint64_t bytes = 0;
+  if (zesVFManagementGetVFMemoryUtilizationExp2(vf, &count, nullptr) !=
+      ZE_RESULT_SUCCESS) {
+    return 0;
+  }
+  std::vector<zes_vf_util_mem_exp2_t> memory(count);
+  for (zes_vf_util_mem_exp2_t &location : memory) {
+    location.stype = ZES_STRUCTURE_TYPE_VF_UTIL_MEM_EXP2;
+  }
+  if (zesVFManagementGetVFMemoryUtilizationExp2(vf, &count, memory.data()) !=
+      ZE_RESULT_SUCCESS) {
+    return 0;
+  }
+  for (const zes_vf_util_mem_exp2_t &location : memory) {
+    bytes += location.vfMemUtilized;
+  }
+  return bytes;
+}
+
+// Percent of the sampling counter the engine group was active for between
+// two readings.
+static double active_percent(const zes_vf_util_engine_exp2_t &start,
+                             const zes_vf_util_engine_exp2_t &end) {
+  if (end.samplingCounterValue <= start.samplingCounterValue) {
+    return 0;
+  }
+  return static_cast<double>(end.activeCounterValue -
+                             start.activeCounterValue) *
+         100.0 /
+         static_cast<double>(end.samplingCounterValue -
+                             start.samplingCounterValue);
+}
+
+static long double mean(const std::vector<long double> &values) {
+  long double sum = 0;
+  for (long double value : values) {
+    sum += value;
+  }
+  return values.empty() ? 0 : sum / values.size();
+}
+
+static long double variation(const std::vector<long double> &values) {
+  long double average = mean(values);
+  long double sum = 0;
+  for (long double value : values) {
+    sum += (value - average) * (value - average);
+  }
+  return values.empty() || average == 0
+             ? 0
+             : std::sqrt(sum / values.size()) * 100 / average;
+}
+
+static long double correlation(const std::vector<long double> &x,
+                               const std::vector<long double> &y) {
+  long double x_mean = mean(x);
+  long double y_mean = mean(y);
+  long double xy = 0;
+  long double xx = 0;
+  long double yy = 0;
+  for (size_t i = 0U; i < x.size() && i < y.size(); i++) {
+    xy += (x[i] - x_mean) * (y[i] - y_mean);
+    xx += (x[i] - x_mean) * (x[i] - x_mean);
+    yy += (y[i] - y_mean) * (y[i] - y_mean);
+  }
+  return xx > 0 && yy > 0 ? xy / std::sqrt(xx * yy) : 0;
+}
+
+void ZeSysmanPerf::report_vf_bin(uint64_t end_msec, uint32_t vf_id,
+                                 const std::vector<vf_engine_util_t> &engines,
+                                 uint64_t mem_bytes) {
+  std::cout << "[" << end_msec << "][vf " << std::setw(2) << vf_id << "]:";
+  for (const vf_engine_util_t &engine : engines) {
+    std::cout << "  " << group_name(engine.group) << " " << std::fixed
+              << std::setprecision(1) << std::setw(5) << engine.mean << "/"
+              << std::setw(5) << engine.peak << " %";
+  }
+  std::cout << "  mem " << std::setprecision(1) << std::setw(8)
+            << mem_bytes / 1048576.0L << " MB" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "VF utilization sample");
+      test_ptree.put("Time(msec since epoch)", end_msec);
+      test_ptree.put("VF", vf_id);
+      for (const vf_engine_util_t &engine : engines) {
+        test_ptree.put(group_name(engine.group) + " mean(%)", engine.mean);
+        test_ptree.put(group_name(engine.group) + " peak(%)", engine.peak);
+      }
+      test_ptree.put("Memory(MB)", mem_bytes / 1048576.0L);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting VF utilization sample: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// Host side: every VF is polled every poll_usec and the rate of the engine
+// counters between polls gives the peak utilization, while the rate over
+// sample_msec gives one sample of the time series. The busiest VF is taken
+// as the noisy one, and the utilization of every other VF is correlated
+// with it: a VF whose utilization drops while the noisy one is busy is not
+// isolated from it.
+void ZeSysmanPerf::vf_sampler(const std::vector<zes_vf_handle_t> &handles) {
+  std::vector<vf_state_t> vfs;
+
+  for (zes_vf_handle_t handle : handles) {
+    vf_state_t vf = {};
+    zes_vf_exp2_capabilities_t capabilities = {};
+    capabilities.stype = ZES_STRUCTURE_TYPE_VF_EXP2_CAPABILITIES;
+    SUCCESS_OR_TERMINATE(
+        zesVFManagementGetVFCapabilitiesExp2(handle, &capabilities));
+    vf.handle = handle;
+    vf.id = capabilities.vfID;
+    if (!read_engines(handle, vf.bin_start)) {
+      std::cout << "[vf " << vf.id << "]:  not supported" << std::endl;
+      continue;
+    }
+    vf.last = vf.bin_start;
+    vf.peak.assign(vf.bin_start.size(), 0);
+    vfs.push_back(vf);
+  }
+  if (vfs.empty()) {
+    return;
+  }
+
+  time_point_t origin = std::chrono::steady_clock::now();
+  for (uint64_t s = 1U; s * sample_msec <= vf_sec * 1000ULL; s++) {
+    const long double sample_end = s * sample_msec * 1000.0L;
+    while (usec_since(origin) < sample_end) {
+      std::this_thread::sleep_for(std::chrono::microseconds(poll_usec));
+      for (vf_state_t &vf : vfs) {
+        std::vector<zes_vf_util_engine_exp2_t> engines;
+        if (!read_engines(vf.handle, engines) ||
+            engines.size() != vf.last.size()) {
+          continue;
+        }
+        for (size_t e = 0U; e < engines.size(); e++) {
+          vf.peak[e] = std::max(vf.peak[e], active_percent(vf.last[e],
+                                                           engines[e]));
+        }
+        vf.last = engines;
+      }
+    }
+
+    const uint64_t end_msec = epoch_msec();
+    for (vf_state_t &vf : vfs) {
+      std::vector<vf_engine_util_t> engines;
+      long double busiest = 0;
+      for (size_t e = 0U; e < vf.last.size(); e++) {
+        vf_engine_util_t engine = {vf.last[e].vfEngineType,
+                                   active_percent(vf.bin_start[e], vf.last[e]),
+                                   vf.peak[e]};
+        busiest = std::max(busiest, static_cast<long double>(engine.mean));
+        engines.push_back(engine);
+      }
+      vf.busiest.push_back(busiest);
+      report_vf_bin(end_msec, vf.id, engines, read_memory(vf.handle));
+      vf.bin_start = vf.last;
+      std::fill(vf.peak.begin(), vf.peak.end(), 0);
+    }
+  }
+
+  const vf_state_t &noisy = *std::max_element(
+      vfs.begin(), vfs.end(), [](const vf_state_t &a, const vf_state_t &b) {
+        return mean(a.busiest) < mean(b.busiest);
+      });
+  for (const vf_state_t &vf : vfs) {
+    long double r = &vf == &noisy ? 1 : correlation(noisy.busiest, vf.busiest);
+    std::cout << "[vf " << std::setw(2) << vf.id << "]:  mean = " << std::fixed
+              << std::setprecision(1) << std::setw(5) << mean(vf.busiest)
+              << " %  variation = " << std::setw(5) << variation(vf.busiest)
+              << " %  correlation with vf " << noisy.id << " = "
+              << std::setprecision(2) << std::setw(5) << r
+              << (&vf == &noisy ? "  noisy" : "") << std::endl;
+
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "VF isolation");
+        test_ptree.put("VF", vf.id);
+        test_ptree.put("Noisy VF", noisy.id);
+        test_ptree.put("Utilization mean(%)", mean(vf.busiest));
+        test_ptree.put("Utilization variation(%)", variation(vf.busiest));
+        test_ptree.put("Correlation with noisy VF", r);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting VF isolation measurement: " << e.what()
+                  << std::endl;
+      }
+    }
+  }
+}
+
+// Guest side, inside the victim VF: compute_loop runs back to back and the
+// throughput of every sample_msec is reported with its wall clock time, to
+// be lined up with the utilization samples of the host.
+void ZeSysmanPerf::vf_victim(void) {
+  // Two multiply-adds of two flops each per loop iteration and work-item.
+  const long double work = 4.0L * work_items * compute_iterations;
+  std::vector<long double> samples;
+
+  time_point_t origin = std::chrono::steady_clock::now();
+  long double sample_start = 0;
+  for (uint64_t s = 1U; s * sample_msec <= vf_sec * 1000ULL; s++) {
+    const long double sample_end = s * sample_msec * 1000.0L;
+    uint64_t launches = 0;
+    while (usec_since(origin) < sample_end) {
+      launch(compute_list);
+      launches++;
+    }
+    long double usec = usec_since(origin);
+    long double gflops = work * launches / (usec - sample_start) / 1000.0L;
+    const uint64_t end_msec = epoch_msec();
+    samples.push_back(gflops);
+    sample_start = usec;
+
+    std::cout << "[" << end_msec << "]:  " << std::fixed
+              << std::setprecision(2) << std::setw(9) << gflops << " Gflops"
+              << std::endl;
+    if (is_json_output_enabled()) {
+      try {
+        ptree test_ptree;
+        test_ptree.put("Name", "VF victim throughput sample");
+        test_ptree.put("Time(msec since epoch)", end_msec);
+        test_ptree.put("Throughput(Gflops)", gflops);
+        param_array.push_back(std::make_pair("", test_ptree));
+      } catch (const std::exception &e) {
+        std::cerr << "Error outputting VF victim throughput sample: "
+                  << e.what() << std::endl;
+      }
+    }
+  }
+  if (samples.empty()) {
+    return;
+  }
+
+  long double lowest = *std::min_element(samples.begin(), samples.end());
+  long double highest = *std::max_element(samples.begin(), samples.end());
+  std::cout << "median = " << std::fixed << std::setprecision(2)
+            << median(samples) << " Gflops  min = " << lowest
+            << " Gflops  max = " << highest
+            << " Gflops  variation = " << std::setprecision(1)
+            << variation(samples) << " %" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "VF victim throughput");
+      test_ptree.put("Median(Gflops)", median(samples));
+      test_ptree.put("Min(Gflops)", lowest);
+      test_ptree.put("Max(Gflops)", highest);
+      test_ptree.put("Variation(%)", variation(samples));
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting VF victim throughput measurement: "
+                << e.what() << std::endl;
+    }
+  }
+}
+
+void ZeSysmanPerf::vf_isolation(void) {
+  uint32_t count = 0;
+
+  ze_result_t result =
+      zesDeviceEnumEnabledVFExp(sysman_devices[0], &count, nullptr);
+  if (result == ZE_RESULT_SUCCESS && count > 0) {
+    std::cout << "Utilization of " << count << " VFs" << std::endl;
+    std::vector<zes_vf_handle_t> handles(count);
+    SUCCESS_OR_TERMINATE(
+        zesDeviceEnumEnabledVFExp(sysman_devices[0], &count, handles.data()));
+    vf_sampler(handles);
+  } else {
+    if (diagnostics) {
+      std::cerr << "WARNING : zesDeviceEnumEnabledVFExp : " << result
+                << ", " << count << " VFs" << std::endl;
+    }
+    std::cout << "No VFs enabled, victim throughput of this device"
+              << std::endl;
+    vf_victim();
+  }
+}
@@ -0,0 +1,257 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+struct standby_config_t {
+  bool change; /* false to measure the mode already in place */
+  zes_standby_promo_mode_t mode;
+};
+
+static std::string mode_name(const standby_config_t &config) {
+  if (!config.change) {
+    return "current";
+  }
+  return config.mode == ZES_STANDBY_PROMO_MODE_NEVER ? "never" : "default";
+}
+
+static double actual_frequency(zes_freq_handle_t freq) {
+  zes_freq_state_t state = {};
+  state.stype = ZES_STRUCTURE_TYPE_FREQ_STATE;
+  if (freq == nullptr || zesFrequencyGetState(freq, &state) !=
+                             ZE_RESULT_SUCCESS) {
+    return 0;
+  }
+  return state.actual;
+}
+
+static bool read_energy(zes_pwr_handle_t power,
+                        zes_power_energy_counter_t *energy) {
+  return power != nullptr &&
+         zesPowerGetEnergyCounter(power, energy) == ZE_RESULT_SUCCESS;
+}
+
+// The device is kept busy with a few launches, then left idle for idle_msec
+// before the first kernel is launched. The frequency is read right before
+// and after that kernel and the energy counter gives the power while idle.
+// The copy is measured the same way after a second idle period. A failed
+// launch ends the trial with its result in status.
+wake_trial_t ZeSysmanPerf::measure_wake(zes_freq_handle_t freq,
+                                        zes_pwr_handle_t power,
+                                        ze_command_list_handle_t copy_list,
+                                        uint32_t idle_msec) {
+  wake_trial_t trial;
+  zes_power_energy_counter_t energy_start = {};
+  zes_power_energy_counter_t energy_end = {};
+  long double usec = 0;
+
+  for (int i = 0; i < 3 && trial.status == ZE_RESULT_SUCCESS; i++) {
+    trial.status = try_launch(compute_list, usec);
+  }
+  if (trial.status != ZE_RESULT_SUCCESS) {
+    return trial;
+  }
+  bool energy = read_energy(power, &energy_start);
+  std::this_thread::sleep_for(std::chrono::milliseconds(idle_msec));
+  energy = read_energy(power, &energy_end) && energy;
+  trial.idle_mhz = actual_frequency(freq);
+  trial.status = try_launch(compute_list, trial.kernel_usec);
+  trial.wake_mhz = actual_frequency(freq);
+  trial.idle_watts = energy ? watts(energy_start, energy_end) : 0;
+
+  for (int i = 0; i < 3 && trial.status == ZE_RESULT_SUCCESS; i++) {
+    trial.status = try_launch(copy_list, usec);
+  }
+  if (trial.status != ZE_RESULT_SUCCESS) {
+    return trial;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(idle_msec));
+  trial.status = try_launch(copy_list, trial.copy_usec);
+  return trial;
+}
+
+void ZeSysmanPerf::report_wake(const std::string &mode, uint32_t idle_msec,
+                               long double warm_kernel_usec,
+                               long double warm_copy_usec,
+                               const std::vector<wake_trial_t> &trials) {
+  std::vector<long double> kernel;
+  std::vector<long double> copy;
+  std::vector<long double> idle_mhz;
+  std::vector<long double> wake_mhz;
+  std::vector<long double> idle_watts;
+  for (const wake_trial_t &trial : trials) {
+    kernel.push_back(trial.kernel_usec);
+    copy.push_back(trial.copy_usec);
+    idle_mhz.push_back(trial.idle_mhz);
+    wake_mhz.push_back(trial.wake_mhz);
+    idle_watts.push_back(trial.idle_watts);
+  }
+  long double kernel_median = median(kernel);
+  long double copy_median = median(copy);
+
+  std::cout << "[" << std::left << std::setw(7) << mode << std::right
+            << "][idle " << std::setw(6) << idle_msec
+            << " msec]:  kernel = " << std::fixed << std::setprecision(1)
+            << std::setw(9) << kernel_median << " usec (+" << std::setw(8)
+            << kernel_median - warm_kernel_usec << ")  copy = " << std::setw(8)
+            << copy_median << " usec (+" << std::setw(8)
+            << copy_median - warm_copy_usec << ")  " << std::setprecision(0)
+            << std::setw(5) << median(idle_mhz) << " -> " << std::setw(5)
+            << median(wake_mhz) << " MHz  " << std::setprecision(2)
+            << std::setw(7) << median(idle_watts) << " W idle" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "Wake latency");
+      test_ptree.put("Standby mode", mode);
+      test_ptree.put("Idle(msec)", idle_msec);
+      test_ptree.put("First kernel(usec)", kernel_median);
+      test_ptree.put("Warm kernel(usec)", warm_kernel_usec);
+      test_ptree.put("First copy(usec)", copy_median);
+      test_ptree.put("Warm copy(usec)", warm_copy_usec);
+      test_ptree.put("Idle frequency(MHz)", median(idle_mhz));
+      test_ptree.put("Wake frequency(MHz)", median(wake_mhz));
+      test_ptree.put("Idle power(W)", median(idle_watts));
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting wake latency measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+// Measures every idle duration with the standby mode in place. Stops at the
+// first failed launch and returns its result.
+ze_result_t ZeSysmanPerf::sweep_idle(const std::string &mode,
+                                     zes_freq_handle_t freq,
+                                     zes_pwr_handle_t power,
+                                     ze_command_list_handle_t copy_list) {
+  // Reference latencies with the device kept busy.
+  std::vector<long double> warm_kernel;
+  std::vector<long double> warm_copy;
+  for (uint32_t i = 0U; i < 10; i++) {
+    long double kernel_usec = 0;
+    long double copy_usec = 0;
+    ze_result_t result = try_launch(compute_list, kernel_usec);
+    if (result == ZE_RESULT_SUCCESS) {
+      result = try_launch(copy_list, copy_usec);
+    }
+    if (result != ZE_RESULT_SUCCESS) {
+      return result;
+    }
+    warm_kernel.push_back(kernel_usec);
+    warm_copy.push_back(copy_usec);
+  }
+
+  for (uint32_t idle_msec : idle_durations) {
+    std::vector<wake_trial_t> trials;
+    for (uint32_t i = 0U; i < number_iterations; i++) {
+      wake_trial_t trial = measure_wake(freq, power, copy_list, idle_msec);
+      if (trial.status != ZE_RESULT_SUCCESS) {
+        return trial.status;
+      }
+      trials.push_back(trial);
+    }
+    report_wake(mode, idle_msec, median(warm_kernel), median(warm_copy),
+                trials);
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+void ZeSysmanPerf::wake_latency(void) {
+  zes_device_handle_t device = sysman_devices[0];
+  ze_command_list_handle_t copy_list = nullptr;
+  void *host_buffer = nullptr;
+  void *device_buffer = nullptr;
+  uint32_t count = 0;
+
+  std::cout << "First kernel and copy latency after idle" << std::endl;
+  zes_freq_handle_t freq = nullptr;
+  SUCCESS_OR_TERMINATE(zesDeviceEnumFrequencyDomains(device, &count, nullptr));
+  std::vector<zes_freq_handle_t> freq_domains(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumFrequencyDomains(device, &count, freq_domains.data()));
+  for (zes_freq_handle_t handle : freq_domains) {
+    zes_freq_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_FREQ_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesFrequencyGetProperties(handle, &properties));
+    if (properties.type == ZES_FREQ_DOMAIN_GPU && freq == nullptr) {
+      freq = handle;
+    }
+  }
+  zes_pwr_handle_t power = power_domain(0);
+
+  SUCCESS_OR_TERMINATE(zesDeviceEnumStandbyDomains(device, &count, nullptr));
+  std::vector<zes_standby_handle_t> standby_domains(count);
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumStandbyDomains(device, &count, standby_domains.data()));
+  std::vector<zes_standby_promo_mode_t> original(count);
+  for (uint32_t s = 0U; s < count; s++) {
+    SUCCESS_OR_TERMINATE(zesStandbyGetMode(standby_domains[s], &original[s]));
+  }
+
+  benchmark->memoryAllocHost(wake_copy_bytes, &host_buffer);
+  benchmark->memoryAlloc(0, wake_copy_bytes, &device_buffer);
+  benchmark->commandListCreate(0, compute_ordinal, &copy_list);
+  benchmark->commandListAppendMemoryCopy(copy_list, device_buffer, host_buffer,
+                                         wake_copy_bytes);
+  benchmark->commandListClose(copy_list);
+
+  std::vector<standby_config_t> configs = {
+      {false, ZES_STANDBY_PROMO_MODE_DEFAULT}};
+  if (count > 0) {
+    configs.push_back({true, ZES_STANDBY_PROMO_MODE_DEFAULT});
+    configs.push_back({true, ZES_STANDBY_PROMO_MODE_NEVER});
+  }
+  ze_result_t result = ZE_RESULT_SUCCESS;
+  {
+    // Puts every domain back to its original mode on every path out of the
+    // sweep, once any of them has been changed.
+    bool changed = false;
+    restore_guard_t restore([&]() {
+      for (uint32_t s = 0U; changed && s < count; s++) {
+        SUCCESS_OR_WARN(zesStandbySetMode(standby_domains[s], original[s]));
+      }
+    });
+
+    for (const standby_config_t &config : configs) {
+      bool applied = true;
+      for (uint32_t s = 0U; config.change && s < count; s++) {
+        ze_result_t set = zesStandbySetMode(standby_domains[s], config.mode);
+        if (set != ZE_RESULT_SUCCESS) {
+          if (diagnostics) {
+            std::cerr << "WARNING : zesStandbySetMode : " << set << std::endl;
+          }
+          applied = false;
+          break;
+        }
+        changed = true;
+      }
+      if (!applied) {
+        std::cout << "[" << std::left << std::setw(7) << mode_name(config)
+                  << std::right << "]:  not supported" << std::endl;
+        continue;
+      }
+
+      result = sweep_idle(mode_name(config), freq, power, copy_list);
+      if (result != ZE_RESULT_SUCCESS) {
+        break;
+      }
+    }
+  }
+  if (result != ZE_RESULT_SUCCESS) {
+    std::cerr << "ERROR : wake latency stopped, original standby modes "
+                 "restored : "
+              << result << std::endl;
+  }
+
+  benchmark->commandListDestroy(copy_list);
+  benchmark->memoryFree(device_buffer);
+  benchmark->memoryFree(host_buffer);
+}
@@ -0,0 +1,323 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_sysman_perf.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdlib.h>
+
+ZeSysmanPerf::ZeSysmanPerf() {
+  uint32_t driver_count = 1;
+
+  // Sysman handles are taken from the core device handles, which requires
+  // sysman to be enabled before zeInit.
+  static char sysman_env[] = "ZES_ENABLE_SYSMAN=1";
+  putenv(sysman_env);
+  // Composite hierarchy unless the user chose one.
+  static char hierarchy_env[] = "ZE_FLAT_DEVICE_HIERARCHY=COMPOSITE";
+  if (getenv("ZE_FLAT_DEVICE_HIERARCHY") == nullptr) {
+    putenv(hierarchy_env);
+  }
+
+  benchmark = new ZeApp("ze_sysman_perf.spv");
+  uint32_t device_count = benchmark->allDevicesInit();
+  SUCCESS_OR_TERMINATE(zeDriverGet(&driver_count, &driver));
+  for (uint32_t i = 0U; i < device_count; i++) {
+    sysman_devices.push_back(
+        reinterpret_cast<zes_device_handle_t>(benchmark->_devices[i]));
+  }
+
+  benchmark->queueGroupOrdinal(0, false, &compute_ordinal);
+  benchmark->commandQueueCreate(0, compute_ordinal, &command_queue);
+  benchmark->commandListCreate(0, compute_ordinal, &compute_list);
+
+  benchmark->functionCreate(&compute_kernel, "compute_loop");
+}
+
+ZeSysmanPerf::~ZeSysmanPerf() {
+  benchmark->functionDestroy(compute_kernel);
+  benchmark->commandListDestroy(compute_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->allDevicesCleanup();
+
+  delete benchmark;
+}
+
+bool ZeSysmanPerf::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+// The worker processes of the scheduler test run after their parent has
+// checked the host, measuring the noise again would only delay their start.
+bool ZeSysmanPerf::setup_environment(void) {
+  if (!worker.empty()) {
+    return true;
+  }
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+long double ZeSysmanPerf::usec_since(time_point_t origin) {
+  return std::chrono::duration<long double, std::micro>(
+             std::chrono::steady_clock::now() - origin)
+      .count();
+}
+
+long double ZeSysmanPerf::percentile(std::vector<long double> values,
+                                     double fraction) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  size_t index =
+      static_cast<size_t>(fraction * static_cast<double>(values.size()));
+  return values[std::min(index, values.size() - 1)];
+}
+
+long double ZeSysmanPerf::median(std::vector<long double> values) {
+  return percentile(values, 0.5);
+}
+
+// Index of the first sample from which every later sample stays within band
+// of the target, or -1 if the last sample is still outside of it.
+int ZeSysmanPerf::settled_index(const std::vector<timed_sample_t> &samples,
+                                double target, double band) {
+  int index = static_cast<int>(samples.size());
+  while (index > 0 && std::fabs(samples[static_cast<size_t>(index - 1)].value -
+                                target) <= band) {
+    index--;
+  }
+  if (index == static_cast<int>(samples.size())) {
+    return -1;
+  }
+  return index;
+}
+
+// The card power domain if there is one, otherwise the first domain covering
+// the whole device.
+zes_pwr_handle_t ZeSysmanPerf::power_domain(uint32_t device) {
+  zes_pwr_handle_t power = nullptr;
+  uint32_t count = 0;
+
+  if (zesDeviceGetCardPowerDomain(sysman_devices[device], &power) ==
+      ZE_RESULT_SUCCESS) {
+    return power;
+  }
+  SUCCESS_OR_TERMINATE(
+      zesDeviceEnumPowerDomains(sysman_devices[device], &count, nullptr));
+  std::vector<zes_pwr_handle_t> domains(count);
+  SUCCESS_OR_TERMINATE(zesDeviceEnumPowerDomains(sysman_devices[device],
+                                                 &count, domains.data()));
+  for (zes_pwr_handle_t domain : domains) {
+    zes_power_properties_t properties = {};
+    properties.stype = ZES_STRUCTURE_TYPE_POWER_PROPERTIES;
+    SUCCESS_OR_TERMINATE(zesPowerGetProperties(domain, &properties));
+    if (!properties.onSubdevice) {
+      return domain;
+    }
+  }
+  return nullptr;
+}
+
+// Average power between two energy counter readings, in watts.
+double ZeSysmanPerf::watts(const zes_power_energy_counter_t &start,
+                           const zes_power_energy_counter_t &end) {
+  if (end.timestamp <= start.timestamp) {
+    return 0;
+  }
+  return static_cast<double>(end.energy - start.energy) /
+         static_cast<double>(end.timestamp - start.timestamp);
+}
+
+void ZeSysmanPerf::set_compute_iterations(uint32_t iterations) {
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      compute_kernel, 0, sizeof(output_buffer), &output_buffer));
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      compute_kernel, 1, sizeof(iterations), &iterations));
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(compute_kernel, work_items, 1,
+                                                1, &group_size_x,
+                                                &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(
+      zeKernelSetGroupSize(compute_kernel, group_size_x, 1, 1));
+  ze_group_count_t group_count = {work_items / group_size_x, 1, 1};
+
+  benchmark->commandListReset(compute_list);
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      compute_list, compute_kernel, &group_count, nullptr, 0, nullptr));
+  benchmark->commandListClose(compute_list);
+  compute_iterations = iterations;
+}
+
+// Size the compute kernel so that one launch takes about kernel_usec at the
+// current frequency, short enough to resolve throughput changes over time.
+void ZeSysmanPerf::calibrate_compute(void) {
+  uint32_t iterations = 1024;
+
+  set_compute_iterations(iterations);
+  launch(compute_list);
+  long double usec = launch(compute_list);
+  while (usec > 0 && usec < kernel_usec / 2.0L && iterations < (1U << 30)) {
+    iterations *= 2;
+    set_compute_iterations(iterations);
+    usec = launch(compute_list);
+  }
+  if (diagnostics) {
+    std::cout << "compute_loop: " << iterations << " iterations, " << usec
+              << " usec per launch" << std::endl;
+  }
+}
+
+// Memory bound reference: a float4 copy between two device buffers, which
+// reads and writes every byte once.
+void ZeSysmanPerf::create_stream(void) {
+  uint32_t group_size_x = 0;
+  uint32_t group_size_y = 0;
+  uint32_t group_size_z = 0;
+  const uint32_t stream_items =
+      static_cast<uint32_t>(stream_size / (4 * sizeof(float)));
+
+  benchmark->memoryAlloc(0, stream_size, &stream_src);
+  benchmark->memoryAlloc(0, stream_size, &stream_dst);
+  benchmark->functionCreate(&stream_kernel, "stream_copy");
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      stream_kernel, 0, sizeof(stream_src), &stream_src));
+  SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+      stream_kernel, 1, sizeof(stream_dst), &stream_dst));
+  SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(stream_kernel, stream_items, 1,
+                                                1, &group_size_x,
+                                                &group_size_y, &group_size_z));
+  SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(stream_kernel, group_size_x, 1, 1));
+  ze_group_count_t group_count = {stream_items / group_size_x, 1, 1};
+  benchmark->commandListCreate(0, compute_ordinal, &stream_list);
+  SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+      stream_list, stream_kernel, &group_count, nullptr, 0, nullptr));
+  benchmark->commandListClose(stream_list);
+
+  stream_bytes =
+      2.0L * group_count.groupCountX * group_size_x * 4 * sizeof(float);
+}
+
+void ZeSysmanPerf::destroy_stream(void) {
+  benchmark->commandListDestroy(stream_list);
+  benchmark->functionDestroy(stream_kernel);
+  benchmark->memoryFree(stream_src);
+  benchmark->memoryFree(stream_dst);
+}
+
+long double ZeSysmanPerf::launch(ze_command_list_handle_t list) {
+  long double usec = 0;
+  SUCCESS_OR_TERMINATE(try_launch(list, usec));
+  return usec;
+}
+
+ze_result_t ZeSysmanPerf::try_launch(ze_command_list_handle_t list,
+                                     long double &usec) {
+  Timer<std::chrono::microseconds::period> timer;
+
+  timer.start();
+  ze_result_t result =
+      zeCommandQueueExecuteCommandLists(command_queue, 1, &list, nullptr);
+  if (result == ZE_RESULT_SUCCESS) {
+    result = zeCommandQueueSynchronize(command_queue, UINT64_MAX);
+  }
+  timer.end();
+
+  usec = timer.period_minus_overhead();
+  return result;
+}
+
+// Launches the list until stopped, recording for each launch its completion
+// time relative to origin and its duration. Below a duty cycle of 1 the host
+// idles after each launch so that the list runs that fraction of the time.
+// A failed launch stops the loop and is kept in workload_result, for the
+// caller to check once it has restored any setting it changed.
+void ZeSysmanPerf::run_until(ze_command_list_handle_t list, double duty_cycle,
+                             const std::atomic<bool> &stop,
+                             time_point_t origin,
+                             std::vector<timed_sample_t> &launches) {
+  workload_result = ZE_RESULT_SUCCESS;
+  while (!stop.load()) {
+    long double usec = 0;
+    ze_result_t result = try_launch(list, usec);
+    if (result != ZE_RESULT_SUCCESS) {
+      workload_result = result;
+      return;
+    }
+    launches.push_back({usec_since(origin), static_cast<double>(usec)});
+    if (duty_cycle < 1.0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(
+          static_cast<int64_t>(usec * (1.0 - duty_cycle) / duty_cycle)));
+    }
+  }
+}
+
+void ZeSysmanPerf::run(void) {
+  benchmark->memoryAlloc(0, work_items * sizeof(float), &output_buffer);
+  if (worker == "latency") {
+    set_compute_iterations(latency_iterations);
+  } else {
+    calibrate_compute();
+  }
+  if (!worker.empty()) {
+    run_worker();
+    benchmark->memoryFree(output_buffer);
+    return;
+  }
+
+  for (const std::string &test : tests) {
+    if (test == "freq_settle") {
+      frequency_settle();
+    } else if (test == "perf_factor") {
+      performance_factor();
+    } else if (test == "scheduler") {
+      scheduler_mode();
+    } else if (test == "events") {
+      event_latency();
+    } else if (test == "telemetry") {
+      telemetry_accuracy();
+    } else if (test == "wake") {
+      wake_latency();
+    } else if (test == "soak") {
+      thermal_soak();
+    } else if (test == "vf") {
+      vf_isolation();
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->memoryFree(output_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.sysman", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeSysmanPerf sysman_perf;
+  SUCCESS_OR_TERMINATE(sysman_perf.parse_command_line(argc, argv));
+  if (!sysman_perf.setup_environment()) {
+    return 1;
+  }
+  sysman_perf.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_TINY_OPS_HPP
+#define ZE_TINY_OPS_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+enum tiny_op_kind_t { TINY_COPY = 0, TINY_FILL = 1, TINY_KERNEL = 2 };
+
+struct tiny_op_t {
+  tiny_op_kind_t kind;
+  size_t size; /* bytes copied or filled, unused for kernels */
+};
+
+struct tiny_engine_t {
+  std::string name;
+  uint32_t ordinal;
+  bool compute;
+};
+
+class ZeTinyOps {
+public:
+  ZeTinyOps();
+  ~ZeTinyOps();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  uint32_t number_iterations = 1000;
+  uint32_t warmup_iterations = 10;
+  uint32_t batch_size = 1000;
+  bool run_single = true;
+  bool run_batched = true;
+  bool run_regular = true;
+  bool run_immediate = true;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  static const size_t max_op_size = 4096;
+
+  void append_ops(ze_command_list_handle_t list, const tiny_op_t &op,
+                  uint32_t count);
+  long double measure_regular(const tiny_engine_t &engine, const tiny_op_t &op,
+                              uint32_t ops_per_submission);
+  long double measure_immediate(const tiny_engine_t &engine,
+                                const tiny_op_t &op,
+                                uint32_t ops_per_submission);
+  void report(const tiny_engine_t &engine, bool immediate,
+              uint32_t ops_per_submission, const tiny_op_t &op,
+              long double latency_usec);
+
+  ZeApp *benchmark;
+  std::vector<tiny_engine_t> engines;
+  ze_kernel_handle_t kernel = nullptr;
+  void *host_buffer = nullptr;
+  void *device_buffer = nullptr;
+};
+
+#endif /* ZE_TINY_OPS_HPP */
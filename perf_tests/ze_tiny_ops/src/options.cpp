@@ -0,0 +1,79 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_tiny_ops.hpp"
+
+int ZeTinyOps::parse_command_line(int argc, char **argv) {
+
+  std::string mode = "all";
+  std::string list_type = "all";
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "warmup", po::value<uint32_t>(&warmup_iterations)->default_value(10),
+        "set number of warmup operations")(
+        "num-iter",
+        po::value<uint32_t>(&number_iterations)->default_value(1000),
+        "set number of submissions per measurement")(
+        "batch", po::value<uint32_t>(&batch_size)->default_value(1000),
+        "set number of operations packed into one list in batched mode, at "
+        "least 2")(
+        "mode", po::value<std::string>(&mode)->default_value("all"),
+        "submit one operation per list (single), batch operations into one "
+        "list (batched) or both (all)")(
+        "list-type", po::value<std::string>(&list_type)->default_value("all"),
+        "command list type like regular/immediate/all")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  run_single = (mode == "single" || mode == "all");
+  run_batched = (mode == "batched" || mode == "all");
+  run_regular = (list_type == "regular" || list_type == "all");
+  run_immediate = (list_type == "immediate" || list_type == "all");
+
+  if (!run_single && !run_batched) {
+    std::cout << "unknown mode " << mode << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (!run_regular && !run_immediate) {
+    std::cout << "unknown list type " << list_type << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (number_iterations == 0 || batch_size == 0) {
+    std::cout << "number of iterations and batch size must be greater than "
+                 "zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  } else if (run_batched && batch_size < 2) {
+    std::cout << "batch size must be at least 2 in batched mode, a batch of "
+                 "one operation is the single mode"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
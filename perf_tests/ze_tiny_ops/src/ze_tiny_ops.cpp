@@ -0,0 +1,246 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_tiny_ops.hpp"
+
+static const tiny_op_t tiny_op_list[] = {
+    {TINY_COPY, 0},    {TINY_COPY, 1}, {TINY_COPY, 64},
+    {TINY_COPY, 4096}, {TINY_FILL, 1}, {TINY_KERNEL, 0}};
+
+static std::string to_string(const tiny_op_t &op) {
+  switch (op.kind) {
+  case TINY_COPY:
+    return "copy " + std::to_string(op.size) + " B";
+  case TINY_FILL:
+    return "fill " + std::to_string(op.size) + " B";
+  case TINY_KERNEL:
+    return "empty kernel";
+  }
+  return "";
+}
+
+ZeTinyOps::ZeTinyOps() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_empty_kernel.spv");
+  benchmark->singleDeviceInit();
+
+  if (benchmark->queueGroupOrdinal(0, false, &ordinal)) {
+    engines.push_back({"compute", ordinal, true});
+  }
+  if (benchmark->queueGroupOrdinal(0, true, &ordinal)) {
+    engines.push_back({"copy", ordinal, false});
+  }
+
+  benchmark->functionCreate(&kernel, "empty_kernel");
+  SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, 1, 1, 1));
+}
+
+ZeTinyOps::~ZeTinyOps() {
+  benchmark->functionDestroy(kernel);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeTinyOps::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeTinyOps::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+// Every operation of a batch works on its own max_op_size slot, copies go
+// from host to device memory and fills write device memory.
+void ZeTinyOps::append_ops(ze_command_list_handle_t list, const tiny_op_t &op,
+                           uint32_t count) {
+  const ze_group_count_t group_count = {1, 1, 1};
+  const uint8_t pattern = 0x5a;
+
+  for (uint32_t i = 0U; i < count; i++) {
+    size_t offset = i * max_op_size;
+    void *dst = static_cast<uint8_t *>(device_buffer) + offset;
+    void *src = static_cast<uint8_t *>(host_buffer) + offset;
+
+    switch (op.kind) {
+    case TINY_COPY:
+      SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryCopy(
+          list, dst, src, op.size, nullptr, 0, nullptr));
+      break;
+    case TINY_FILL:
+      SUCCESS_OR_TERMINATE(zeCommandListAppendMemoryFill(
+          list, dst, &pattern, sizeof(pattern), op.size, nullptr, 0, nullptr));
+      break;
+    case TINY_KERNEL:
+      SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+          list, kernel, &group_count, nullptr, 0, nullptr));
+      break;
+    }
+  }
+}
+
+// Returns the average time per operation: the list is recorded once and
+// every submission executes it and waits for it on the host.
+long double ZeTinyOps::measure_regular(const tiny_engine_t &engine,
+                                       const tiny_op_t &op,
+                                       uint32_t ops_per_submission) {
+  Timer<std::chrono::microseconds::period> timer;
+  ze_command_queue_handle_t command_queue;
+  ze_command_list_handle_t command_list;
+
+  benchmark->commandQueueCreate(0, engine.ordinal, &command_queue);
+  benchmark->commandListCreate(0, engine.ordinal, &command_list);
+  append_ops(command_list, op, ops_per_submission);
+  benchmark->commandListClose(command_list);
+
+  for (uint32_t i = 0U; i < warmup_iterations; i++) {
+    benchmark->commandQueueExecuteCommandList(command_queue, 1,
+                                              &command_list);
+    benchmark->commandQueueSynchronize(command_queue);
+  }
+
+  timer.start();
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+        command_queue, 1, &command_list, nullptr));
+    SUCCESS_OR_TERMINATE(zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+  }
+  timer.end();
+
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+
+  return timer.period_minus_overhead() /
+         (static_cast<long double>(number_iterations) * ops_per_submission);
+}
+
+// Returns the average time per operation: every submission appends the
+// operations to the immediate list and waits for them on the host.
+long double ZeTinyOps::measure_immediate(const tiny_engine_t &engine,
+                                         const tiny_op_t &op,
+                                         uint32_t ops_per_submission) {
+  Timer<std::chrono::microseconds::period> timer;
+  ze_command_list_handle_t command_list;
+
+  benchmark->immediateCommandListCreate(0, engine.ordinal, 0, &command_list);
+
+  for (uint32_t i = 0U; i < warmup_iterations; i++) {
+    append_ops(command_list, op, ops_per_submission);
+    SUCCESS_OR_TERMINATE(
+        zeCommandListHostSynchronize(command_list, UINT64_MAX));
+  }
+
+  timer.start();
+  for (uint32_t i = 0U; i < number_iterations; i++) {
+    append_ops(command_list, op, ops_per_submission);
+    SUCCESS_OR_TERMINATE(
+        zeCommandListHostSynchronize(command_list, UINT64_MAX));
+  }
+  timer.end();
+
+  benchmark->commandListDestroy(command_list);
+
+  return timer.period_minus_overhead() /
+         (static_cast<long double>(number_iterations) * ops_per_submission);
+}
+
+void ZeTinyOps::report(const tiny_engine_t &engine, bool immediate,
+                       uint32_t ops_per_submission, const tiny_op_t &op,
+                       long double latency_usec) {
+  long double ops_per_second = 1e6 / latency_usec;
+  std::string list_type = immediate ? "immediate" : "regular";
+  std::string mode = ops_per_submission == 1 ? "single" : "batched";
+
+  std::cout << "[" << std::left << std::setw(7) << engine.name << "]["
+            << std::setw(9) << list_type << "][" << std::setw(7) << mode
+            << "] " << std::setw(13) << to_string(op) << std::right
+            << ":  Latency = " << std::fixed << std::setw(9)
+            << std::setprecision(3) << latency_usec
+            << " usec  Rate = " << std::setw(12) << std::setprecision(0)
+            << ops_per_second << " ops/s" << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", to_string(op));
+      test_ptree.put("Engine", engine.name);
+      test_ptree.put("List type", list_type);
+      test_ptree.put("Mode", mode);
+      test_ptree.put("Ops per submission", ops_per_submission);
+      test_ptree.put("Latency(usec)", latency_usec);
+      test_ptree.put("Ops per second", ops_per_second);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting tiny operation measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void ZeTinyOps::run(void) {
+  std::vector<uint32_t> ops_per_submission;
+  if (run_single) {
+    ops_per_submission.push_back(1);
+  }
+  if (run_batched) {
+    ops_per_submission.push_back(batch_size);
+  }
+
+  benchmark->memoryAllocHost(batch_size * max_op_size, &host_buffer);
+  benchmark->memoryAlloc(0, batch_size * max_op_size, &device_buffer);
+  memset(host_buffer, 0, batch_size * max_op_size);
+
+  for (const tiny_engine_t &engine : engines) {
+    for (uint32_t count : ops_per_submission) {
+      for (const tiny_op_t &op : tiny_op_list) {
+        // Kernels can only be submitted to compute engines.
+        if (op.kind == TINY_KERNEL && !engine.compute) {
+          continue;
+        }
+        if (run_regular) {
+          report(engine, false, count, op,
+                 measure_regular(engine, op, count));
+        }
+        if (run_immediate) {
+          report(engine, true, count, op,
+                 measure_immediate(engine, op, count));
+        }
+      }
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  benchmark->memoryFree(host_buffer);
+  benchmark->memoryFree(device_buffer);
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.tiny_ops", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeTinyOps tiny_ops;
+  SUCCESS_OR_TERMINATE(tiny_ops.parse_command_line(argc, argv));
+  if (!tiny_ops.setup_environment()) {
+    return 1;
+  }
+  tiny_ops.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef ZE_USM_ATOMICS_HPP
+#define ZE_USM_ATOMICS_HPP
+
+#include "common.hpp"
+#include <level_zero/ze_api.h>
+#include "ze_app.hpp"
+#include "ze_env_guard.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace po = boost::program_options;
+namespace pt = boost::property_tree;
+using namespace pt;
+
+struct atomic_attribute_t {
+  std::string name;
+  bool set;                                /* false: allocation default */
+  ze_memory_atomic_attr_exp_flags_t flags;
+};
+
+struct atomic_result_t {
+  bool supported = false;
+  long double device_ops_per_second = 0;
+  long double host_ops_per_second = 0;
+  uint64_t lost_updates = 0; /* expected minus observed increments */
+};
+
+class ZeUsmAtomics {
+public:
+  ZeUsmAtomics();
+  ~ZeUsmAtomics();
+  int parse_command_line(int argc, char **argv);
+  bool is_json_output_enabled(void);
+  bool setup_environment(void);
+  void run(void);
+
+  std::vector<uint32_t> cache_lines;
+  uint32_t work_items = 16384;
+  uint32_t device_iterations = 1000;
+  uint32_t host_threads = 1;
+  uint32_t number_iterations = 5;
+  bool report_rejected = false;
+  std::string JsonFileName;
+  ZeEnvGuard env_guard;
+  ptree param_array;
+
+private:
+  static const uint32_t uints_per_line = 16; /* 64 byte cache lines */
+
+  bool set_attribute(const atomic_attribute_t &attribute, void *ptr,
+                     size_t size);
+  atomic_result_t measure(const atomic_attribute_t &attribute, uint32_t lines,
+                          bool device, uint32_t threads);
+  void report(const std::string &scenario,
+              const atomic_attribute_t &attribute, uint32_t lines,
+              uint32_t threads, const atomic_result_t &result);
+
+  ZeApp *benchmark;
+  std::vector<atomic_attribute_t> attributes;
+  ze_kernel_handle_t kernel = nullptr;
+  ze_command_queue_handle_t command_queue = nullptr;
+  ze_command_list_handle_t command_list = nullptr;
+};
+
+#endif /* ZE_USM_ATOMICS_HPP */
@@ -0,0 +1,16 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+kernel void atomic_increment(global atomic_uint *counters, uint lines,
+                             uint iterations) {
+  const uint line = (uint)get_global_id(0) % lines;
+  for (uint i = 0; i < iterations; i++) {
+    atomic_fetch_add_explicit(&counters[line * 16], 1, memory_order_relaxed,
+                              memory_scope_all_svm_devices);
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_usm_atomics.hpp"
+
+int ZeUsmAtomics::parse_command_line(int argc, char **argv) {
+
+  // Declare the supported options.
+  po::variables_map vm;
+  po::options_description desc("Allowed options");
+  try {
+    desc.add_options()("help", "produce help message")(
+        "lines",
+        po::value<std::vector<uint32_t>>(&cache_lines)
+            ->multitoken()
+            ->default_value({1, 64}, "1 64"),
+        "set numbers of 64 byte cache lines the counters are spread over")(
+        "work-items", po::value<uint32_t>(&work_items)->default_value(16384),
+        "set number of device work-items incrementing counters")(
+        "device-iter",
+        po::value<uint32_t>(&device_iterations)->default_value(1000),
+        "set number of increments per work-item")(
+        "host-threads", po::value<uint32_t>(&host_threads)->default_value(1),
+        "set number of host threads incrementing the same counters")(
+        "num-iter", po::value<uint32_t>(&number_iterations)->default_value(5),
+        "set number of iterations")(
+        "report-rejected", po::bool_switch(&report_rejected),
+        "print the atomic access attributes the driver rejects")(
+        "json-output-file", po::value<std::string>(&JsonFileName),
+        "test output format file name to be specified");
+
+    desc.add(env_guard.options());
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << desc << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(0);
+  }
+
+  for (uint32_t lines : cache_lines) {
+    if (lines == 0) {
+      std::cout << "number of cache lines must be greater than zero"
+                << std::endl;
+      std::cout << desc << std::endl;
+      return 1;
+    }
+  }
+  if (work_items == 0 || device_iterations == 0 || host_threads == 0 ||
+      number_iterations == 0) {
+    std::cout << "work-items, iterations and host threads must be greater "
+                 "than zero"
+              << std::endl;
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "ze_usm_atomics.hpp"
+
+#include <atomic>
+#include <thread>
+
+static const std::chrono::milliseconds host_only_duration(100);
+
+ZeUsmAtomics::ZeUsmAtomics() {
+  uint32_t ordinal = 0;
+
+  benchmark = new ZeApp("ze_usm_atomics.spv");
+  benchmark->singleDeviceInit();
+
+  attributes.push_back({"default", false, 0});
+  attributes.push_back(
+      {"no atomics", true, ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_NO_ATOMICS});
+  attributes.push_back(
+      {"device atomics", true, ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_DEVICE_ATOMICS});
+  attributes.push_back(
+      {"host atomics", true, ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_HOST_ATOMICS});
+  attributes.push_back({"device+host atomics", true,
+                        ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_DEVICE_ATOMICS |
+                            ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_HOST_ATOMICS});
+  attributes.push_back(
+      {"system atomics", true, ZE_MEMORY_ATOMIC_ATTR_EXP_FLAG_SYSTEM_ATOMICS});
+
+  benchmark->queueGroupOrdinal(0, false, &ordinal);
+  benchmark->commandQueueCreate(0, ordinal, &command_queue);
+  benchmark->commandListCreate(0, ordinal, &command_list);
+  benchmark->functionCreate(&kernel, "atomic_increment");
+}
+
+ZeUsmAtomics::~ZeUsmAtomics() {
+  benchmark->functionDestroy(kernel);
+  benchmark->commandListDestroy(command_list);
+  benchmark->commandQueueDestroy(command_queue);
+  benchmark->singleDeviceCleanup();
+
+  delete benchmark;
+}
+
+bool ZeUsmAtomics::is_json_output_enabled(void) {
+  return JsonFileName.size() != 0;
+}
+
+bool ZeUsmAtomics::setup_environment(void) {
+  return env_guard.setup(benchmark->_devices[0]);
+}
+
+// Returns false if the driver rejects the attribute for this allocation.
+bool ZeUsmAtomics::set_attribute(const atomic_attribute_t &attribute,
+                                 void *ptr, size_t size) {
+  if (!attribute.set) {
+    return true;
+  }
+  ze_result_t result = zeMemSetAtomicAccessAttributeExp(
+      benchmark->context, benchmark->_devices[0], ptr, size, attribute.flags);
+  if (result != ZE_RESULT_SUCCESS && report_rejected) {
+    std::cerr << "WARNING : zeMemSetAtomicAccessAttributeExp(" << attribute.name
+              << ") : " << result << std::endl;
+  }
+  return result == ZE_RESULT_SUCCESS;
+}
+
+// Device work-items and host threads increment counters placed on separate
+// cache lines of one shared allocation. With both enabled, the host threads
+// hammer the counters for as long as the kernel runs.
+atomic_result_t ZeUsmAtomics::measure(const atomic_attribute_t &attribute,
+                                      uint32_t lines, bool device,
+                                      uint32_t threads) {
+  atomic_result_t result;
+  size_t size = lines * uints_per_line * sizeof(uint32_t);
+  uint32_t *counters = nullptr;
+
+  benchmark->memoryAllocShared(0, size, reinterpret_cast<void **>(&counters));
+  memset(counters, 0, size);
+  if (!set_attribute(attribute, counters, size)) {
+    benchmark->memoryFree(counters);
+    return result;
+  }
+  result.supported = true;
+
+  uint64_t device_ops = 0;
+  if (device) {
+    uint32_t group_size_x = 0;
+    uint32_t group_size_y = 0;
+    uint32_t group_size_z = 0;
+    SUCCESS_OR_TERMINATE(zeKernelSuggestGroupSize(
+        kernel, work_items, 1, 1, &group_size_x, &group_size_y,
+        &group_size_z));
+    SUCCESS_OR_TERMINATE(zeKernelSetGroupSize(kernel, group_size_x, 1, 1));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 0, sizeof(counters), &counters));
+    SUCCESS_OR_TERMINATE(
+        zeKernelSetArgumentValue(kernel, 1, sizeof(lines), &lines));
+    SUCCESS_OR_TERMINATE(zeKernelSetArgumentValue(
+        kernel, 2, sizeof(device_iterations), &device_iterations));
+    ze_group_count_t group_count = {work_items / group_size_x, 1, 1};
+    device_ops = static_cast<uint64_t>(group_count.groupCountX) *
+                 group_size_x * device_iterations;
+
+    benchmark->commandListReset(command_list);
+    SUCCESS_OR_TERMINATE(zeCommandListAppendLaunchKernel(
+        command_list, kernel, &group_count, nullptr, 0, nullptr));
+    benchmark->commandListClose(command_list);
+  }
+
+  for (uint32_t iteration = 0U; iteration < number_iterations; iteration++) {
+    Timer<std::chrono::microseconds::period> timer;
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<uint64_t> host_ops(threads, 0);
+    std::vector<std::thread> workers;
+
+    memset(counters, 0, size);
+    for (uint32_t t = 0U; t < threads; t++) {
+      workers.emplace_back([&, t]() {
+        uint64_t ops = 0;
+        while (!start.load()) {
+          std::this_thread::yield();
+        }
+        while (!stop.load(std::memory_order_relaxed)) {
+          uint32_t line = static_cast<uint32_t>((t + ops) % lines);
+          std::atomic_ref<uint32_t>(counters[line * uints_per_line])
+              .fetch_add(1, std::memory_order_relaxed);
+          ops++;
+        }
+        host_ops[t] = ops;
+      });
+    }
+
+    timer.start();
+    start.store(true);
+    if (device) {
+      SUCCESS_OR_TERMINATE(zeCommandQueueExecuteCommandLists(
+          command_queue, 1, &command_list, nullptr));
+      SUCCESS_OR_TERMINATE(
+          zeCommandQueueSynchronize(command_queue, UINT64_MAX));
+    } else {
+      std::this_thread::sleep_for(host_only_duration);
+    }
+    stop.store(true);
+    timer.end();
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+
+    long double seconds = timer.period_minus_overhead() / 1e6;
+    uint64_t expected = 0;
+    if (device) {
+      result.device_ops_per_second += device_ops / seconds;
+      expected += device_ops;
+    }
+    for (uint64_t ops : host_ops) {
+      result.host_ops_per_second += ops / seconds;
+      expected += ops;
+    }
+
+    uint64_t observed = 0;
+    for (uint32_t line = 0U; line < lines; line++) {
+      observed += counters[line * uints_per_line];
+    }
+    // Counters are 32-bit, compare modulo 2^32.
+    result.lost_updates +=
+        static_cast<uint32_t>(expected) - static_cast<uint32_t>(observed);
+  }
+
+  result.device_ops_per_second /= number_iterations;
+  result.host_ops_per_second /= number_iterations;
+
+  benchmark->memoryFree(counters);
+  return result;
+}
+
+void ZeUsmAtomics::report(const std::string &scenario,
+                          const atomic_attribute_t &attribute, uint32_t lines,
+                          uint32_t threads, const atomic_result_t &result) {
+  std::cout << "[" << std::left << std::setw(11) << scenario << "]["
+            << std::setw(19) << attribute.name << "]" << std::right << "["
+            << std::setw(4) << lines << " lines]:";
+  if (!result.supported) {
+    std::cout << "  not supported" << std::endl;
+    return;
+  }
+  std::cout << "  Device = " << std::fixed << std::setprecision(1)
+            << std::setw(9) << result.device_ops_per_second / 1e6
+            << " Mops/s  Host = " << std::setw(9)
+            << result.host_ops_per_second / 1e6
+            << " Mops/s  Lost updates = " << result.lost_updates << std::endl;
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree test_ptree;
+      test_ptree.put("Name", "USM atomics");
+      test_ptree.put("Scenario", scenario);
+      test_ptree.put("Attribute", attribute.name);
+      test_ptree.put("Cache lines", lines);
+      test_ptree.put("Host threads", threads);
+      test_ptree.put("Device ops per second", result.device_ops_per_second);
+      test_ptree.put("Host ops per second", result.host_ops_per_second);
+      test_ptree.put("Lost updates", result.lost_updates);
+      param_array.push_back(std::make_pair("", test_ptree));
+    } catch (const std::exception &e) {
+      std::cerr << "Error outputting USM atomics measurement: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+void ZeUsmAtomics::run(void) {
+  for (uint32_t lines : cache_lines) {
+    for (const atomic_attribute_t &attribute : attributes) {
+      report("device", attribute, lines, 0,
+             measure(attribute, lines, true, 0));
+      report("host", attribute, lines, host_threads,
+             measure(attribute, lines, false, host_threads));
+      report("host+device", attribute, lines, host_threads,
+             measure(attribute, lines, true, host_threads));
+    }
+    std::cout << "-----------------------------------------------------"
+                 "---------------------------\n";
+  }
+
+  if (is_json_output_enabled()) {
+    try {
+      ptree ptree_main;
+      ptree_main.put_child("Performance Benchmark.usm_atomics", param_array);
+      env_guard.add_to(ptree_main);
+      pt::write_json(JsonFileName.c_str(), ptree_main);
+    } catch (const std::exception &e) {
+      std::cerr << "Error writing json output: " << e.what() << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ZeUsmAtomics usm_atomics;
+  SUCCESS_OR_TERMINATE(usm_atomics.parse_command_line(argc, argv));
+  if (!usm_atomics.setup_environment()) {
+    return 1;
+  }
+  usm_atomics.run();
+
+  std::cout << std::flush;
+
+  return 0;
+}
@@ -0,0 +1,401 @@
+#!/usr/bin/env python3
+# Copyright (C) 2025 Intel Corporation
+# SPDX-License-Identifier: MIT
+import argparse
+import json
+import logging
+import math
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+logger = logging.getLogger(__name__)
+logger.setLevel(logging.INFO)
+handler = logging.StreamHandler(sys.stdout)
+formatter = logging.Formatter("%(asctime)s [%(levelname)s] %(message)s")
+handler.setFormatter(formatter)
+logger.addHandler(handler)
+
+# Bimodality coefficient of a uniform distribution, larger values suggest
+# two or more modes.
+BIMODALITY_THRESHOLD = 5.0 / 9.0
+
+# Suffixes of the fields which ZeSampleStats writes next to a mean, giving
+# the spread and number of the iterations it was computed from.
+STATS_SUFFIXES = (" stddev", " samples")
+
+
+def main(args=None):
+    if not args:
+        args = process_command_line()
+    logger.debug("Arguments: %s", args)
+
+    try:
+        if args.results:
+            results = [load_results(path) for path in args.results]
+        else:
+            if not args.command:
+                logger.error("No perf binary given, see --help")
+                return -1
+            results = collect_results(args)
+        results = [result for result in results if result is not None]
+        if len(results) < 2:
+            logger.error("At least 2 successful runs are needed, got %d", len(results))
+            return -1
+
+        report = analyze(results, args)
+        print_report(report, len(results))
+        if args.json_output_file:
+            with open(args.json_output_file, "w") as file:
+                json.dump(report, file, indent=2)
+        return 0
+    except:
+        logger.exception("Fatal error")
+        return -1
+
+
+def process_command_line():
+    parser = argparse.ArgumentParser(
+        description="Runs a perf binary N times in fresh processes and splits the "
+        "variance of each measurement of its JSON output into between-run and "
+        "within-run parts.",
+        usage="%(prog)s [options] -- <perf binary> [binary arguments]",
+    )
+    setup_parser(parser)
+    return parser.parse_args()
+
+
+def setup_parser(root_parser):
+    root_parser.add_argument(
+        "--runs", type=int, default=10, help="number of processes to launch, default 10"
+    )
+    root_parser.add_argument(
+        "--timeout", type=int, default=None, help="timeout of each run in seconds"
+    )
+    root_parser.add_argument(
+        "--keep-results",
+        type=Path,
+        default=None,
+        help="directory where the JSON output of each run is kept",
+    )
+    root_parser.add_argument(
+        "--results",
+        type=Path,
+        nargs="+",
+        default=None,
+        help="analyze JSON outputs of earlier runs instead of running a binary",
+    )
+    root_parser.add_argument(
+        "--key-fields",
+        default=None,
+        help="comma separated fields which identify a measurement, default: the "
+        "fields which are not numbers or have the same value in every run, give "
+        "them to pool repeated tests of a run reliably",
+    )
+    root_parser.add_argument(
+        "--icc-threshold",
+        type=float,
+        default=0.5,
+        help="flag measurements whose between-run share of the variance is at "
+        "least this, default 0.5",
+    )
+    root_parser.add_argument(
+        "--cv-threshold",
+        type=float,
+        default=1.0,
+        help="ignore measurements whose between-run coefficient of variation is "
+        "below this percentage, default 1.0",
+    )
+    root_parser.add_argument(
+        "--json-output-file", default=None, help="write the report as JSON"
+    )
+    root_parser.add_argument(
+        "command",
+        nargs=argparse.REMAINDER,
+        help="perf binary and its arguments, --json-output-file is appended",
+    )
+
+
+def collect_results(args):
+    command = args.command[1:] if args.command[:1] == ["--"] else args.command
+    if args.keep_results:
+        args.keep_results.mkdir(parents=True, exist_ok=True)
+    results = []
+    with tempfile.TemporaryDirectory() as directory:
+        for run in range(args.runs):
+            json_file = Path(directory) / ("run_%d.json" % run)
+            logger.info("Run %d/%d: %s", run + 1, args.runs, " ".join(command))
+            try:
+                process = subprocess.run(
+                    command + ["--json-output-file", str(json_file)],
+                    stdout=subprocess.PIPE,
+                    stderr=subprocess.STDOUT,
+                    timeout=args.timeout,
+                )
+            except subprocess.TimeoutExpired:
+                logger.warning("Run %d timed out", run + 1)
+                continue
+            if process.returncode != 0 or not json_file.exists():
+                logger.warning(
+                    "Run %d failed with code %d:\n%s",
+                    run + 1,
+                    process.returncode,
+                    process.stdout.decode(errors="replace"),
+                )
+                continue
+            if args.keep_results:
+                shutil.copy(json_file, args.keep_results / json_file.name)
+            results.append(load_results(json_file))
+    return results
+
+
+def load_results(path):
+    with open(path, "r") as file:
+        try:
+            tree = json.load(file)
+        except ValueError:
+            logger.warning("%s is not valid JSON, skipped", path)
+            return None
+    if "Performance Benchmark" not in tree:
+        logger.warning("%s has no Performance Benchmark results, skipped", path)
+        return None
+    return tree["Performance Benchmark"]
+
+
+def to_number(value):
+    # boost::property_tree writes every value as a string
+    try:
+        number = float(value)
+    except (TypeError, ValueError):
+        return None
+    return number if math.isfinite(number) else None
+
+
+def entry_lists(results):
+    """Returns {benchmark: [entries of run 0, entries of run 1, ...]}, an
+    entry being a flat dict of field to value. Arrays of tests are kept as
+    they are, other subtrees become a single entry of their scalar values.
+    The environment subtree describes the host, not a measurement."""
+    lists = {}
+    for run, tree in enumerate(results):
+        for benchmark, subtree in tree.items():
+            if benchmark == "environment":
+                continue
+            if isinstance(subtree, list):
+                entries = [entry for entry in subtree if isinstance(entry, dict)]
+            elif isinstance(subtree, dict):
+                entries = [
+                    {
+                        field: value
+                        for field, value in subtree.items()
+                        if not isinstance(value, (dict, list))
+                    }
+                ]
+            else:
+                entries = [{"Value": subtree}]
+            lists.setdefault(benchmark, [[] for _ in results])[run] = entries
+    return lists
+
+
+def stats_fields(entry):
+    """Fields of entry which describe the iterations of another field."""
+    return {
+        field
+        for field in entry
+        for suffix in STATS_SUFFIXES
+        if field.endswith(suffix) and field[: -len(suffix)] in entry
+    }
+
+
+def key_fields_of(runs, key_fields):
+    """Fields identifying the entries of a benchmark, chosen once so every
+    entry is labelled by the same fields. Binaries list their tests in the
+    same order every run, so a field is taken as a parameter of the tests if
+    it is not a number, or if it has the same value at every position in
+    every run. Measurements which only repeat by chance at some positions
+    are not keys, but a measurement which never changes is: pass key_fields
+    to pool the within-run samples reliably."""
+    if key_fields is not None:
+        return key_fields
+    positions = min(len(entries) for entries in runs)
+    fields = []
+    for position in range(positions):
+        entry = runs[0][position]
+        for field in entry:
+            if field not in fields and field not in stats_fields(entry):
+                fields.append(field)
+
+    def is_key(field):
+        values = [
+            [entries[position].get(field) for entries in runs]
+            for position in range(positions)
+        ]
+        if all(to_number(value) is None for column in values for value in column):
+            return True
+        return all(value == column[0] for column in values for value in column)
+
+    return [field for field in fields if is_key(field)]
+
+
+def group_samples(runs, key_fields):
+    """Returns {(label, metric): [[samples of run 0], [samples of run 1], ...]},
+    a sample being the (mean, standard deviation, count) of the iterations
+    behind a value, or (value, 0, 1) when the binary does not give them.
+    Entries of one run with the same label, e.g. a size listed twice on the
+    command line, are further within-run samples of a measurement."""
+    fields = key_fields_of(runs, key_fields)
+    positions = min(len(entries) for entries in runs)
+    groups = {}
+    for run, entries in enumerate(runs):
+        for entry in entries[:positions]:
+            label = ", ".join(
+                "%s=%s" % (field, entry[field]) for field in fields if field in entry
+            )
+            stats = stats_fields(entry)
+            for metric, value in entry.items():
+                number = to_number(value)
+                if metric in fields or metric in stats or number is None:
+                    continue
+                stddev = to_number(entry.get(metric + " stddev"))
+                count = to_number(entry.get(metric + " samples"))
+                if stddev is None or count is None or count < 1:
+                    stddev, count = 0.0, 1
+                samples = groups.setdefault((label, metric), [[] for _ in runs])
+                samples[run].append((number, stddev, int(count)))
+    return groups
+
+
+def mean(values):
+    return sum(values) / len(values)
+
+
+def bimodality_coefficient(values):
+    """Sarle's bimodality coefficient with the sample size corrected skewness
+    and excess kurtosis, None for fewer than 4 values or no spread."""
+    n = len(values)
+    if n < 4:
+        return None
+    m = mean(values)
+    m2 = sum((x - m) ** 2 for x in values) / n
+    if m2 == 0:
+        return None
+    m3 = sum((x - m) ** 3 for x in values) / n
+    m4 = sum((x - m) ** 4 for x in values) / n
+    skewness = m3 / m2**1.5 * math.sqrt(n * (n - 1)) / (n - 2)
+    kurtosis = (n - 1) / ((n - 2) * (n - 3)) * ((n + 1) * (m4 / m2**2 - 3) + 6)
+    return (skewness**2 + 1) / (kurtosis + 3 * (n - 1) ** 2 / ((n - 2) * (n - 3)))
+
+
+def pool(samples):
+    """Count, mean and sum of squared deviations of the iterations behind
+    the samples of one run."""
+    count = sum(n for _, _, n in samples)
+    run_mean = sum(n * m for m, _, n in samples) / count
+    squares = sum((n - 1) * sd**2 + n * (m - run_mean) ** 2 for m, sd, n in samples)
+    return count, run_mean, squares
+
+
+def decompose(samples):
+    """One-way random effects ANOVA over runs, on the iterations pooled from
+    the samples of each run. Returns the between-run and within-run variance
+    components, the within-run one being None when every run has a single
+    iteration."""
+    runs = [pool(run) for run in samples if run]
+    k = len(runs)
+    n = sum(count for count, _, _ in runs)
+    grand_mean = sum(count * m for count, m, _ in runs) / n
+    if n == k:
+        if k < 2:
+            return grand_mean, 0.0, None
+        return (
+            grand_mean,
+            sum((m - grand_mean) ** 2 for _, m, _ in runs) / (k - 1),
+            None,
+        )
+    ss_between = sum(count * (m - grand_mean) ** 2 for count, m, _ in runs)
+    ss_within = sum(squares for _, _, squares in runs)
+    ms_between = ss_between / (k - 1) if k > 1 else 0.0
+    ms_within = ss_within / (n - k)
+    n0 = (n - sum(count**2 for count, _, _ in runs) / n) / (k - 1) if k > 1 else 1.0
+    return grand_mean, max(0.0, (ms_between - ms_within) / n0), ms_within
+
+
+def analyze(results, args):
+    key_fields = args.key_fields.split(",") if args.key_fields else None
+    report = []
+    for benchmark, runs in sorted(entry_lists(results).items()):
+        if len(set(len(entries) for entries in runs)) > 1:
+            logger.warning(
+                "%s has a different number of tests between runs, only the "
+                "first %d are compared",
+                benchmark,
+                min(len(entries) for entries in runs),
+            )
+        for (label, metric), samples in group_samples(runs, key_fields).items():
+            grand_mean, between, within = decompose(samples)
+            runs = [pool(run) for run in samples if run]
+            run_means = [m for _, m, _ in runs]
+            icc = None
+            if within is not None:
+                icc = between / (between + within) if between + within > 0 else 0.0
+            cv = 100 * math.sqrt(between) / abs(grand_mean) if grand_mean else 0.0
+            bimodality = bimodality_coefficient(run_means)
+
+            flags = []
+            if cv >= args.cv_threshold:
+                # Without within-run samples the share of the variance is not
+                # known, only that the run means spread
+                if icc is None:
+                    flags.append("high-CV")
+                elif icc >= args.icc_threshold:
+                    flags.append("between-run")
+                if bimodality is not None and bimodality > BIMODALITY_THRESHOLD:
+                    flags.append("bimodal")
+            report.append(
+                {
+                    "Benchmark": benchmark,
+                    "Test": label,
+                    "Metric": metric,
+                    "Runs": len(run_means),
+                    "Samples per run": max(count for count, _, _ in runs),
+                    "Mean": grand_mean,
+                    "Between-run variance": between,
+                    "Within-run variance": within,
+                    "ICC": icc,
+                    "Between-run CV(%)": cv,
+                    "Bimodality coefficient": bimodality,
+                    "Unstable": flags,
+                }
+            )
+    return report
+
+
+def print_report(report, runs):
+    def fmt(value, precision=3):
+        return "-" if value is None else "%.*f" % (precision, value)
+
+    print("\nRun-to-run variance over %d processes\n" % runs)
+    print("%-8s %-8s %-10s %-8s %-8s %s" % ("CV(%)", "ICC", "Mean", "BC", "Samples", "Measurement"))
+    for row in report:
+        print(
+            "%-8s %-8s %-10s %-8s %-8d %s: %s [%s]%s"
+            % (
+                fmt(row["Between-run CV(%)"], 2),
+                fmt(row["ICC"]),
+                "%.4g" % row["Mean"],
+                fmt(row["Bimodality coefficient"]),
+                row["Samples per run"],
+                row["Benchmark"],
+                row["Test"],
+                row["Metric"],
+                "  UNSTABLE: " + ", ".join(row["Unstable"]) if row["Unstable"] else "",
+            )
+        )
+    unstable = sum(1 for row in report if row["Unstable"])
+    print("\n%d of %d measurements are unstable between runs" % (unstable, len(report)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,110 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef level_zero_tests_UTILS_COVERING_ARRAY_HPP
+#define level_zero_tests_UTILS_COVERING_ARRAY_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace level_zero_tests {
+
+// Rows of a covering array of the given strength over parameters with
+// value_counts values each: for any strength parameters, every combination
+// of their values appears in at least one row. A row holds one value index
+// per parameter. A strength of 0, or of at least the number of parameters,
+// gives the full cartesian product in the order of ::testing::Combine.
+// Rows are picked greedily among candidates drawn from a generator seeded
+// with seed, so the same arguments always give the same rows.
+std::vector<std::vector<size_t>>
+covering_array(const std::vector<size_t> &value_counts, uint32_t strength,
+               uint32_t seed);
+
+// Strength for CoveringCombine, from LZT_COMBINE_STRENGTH: "full" or 0 for
+// the full matrix, a number for t-way coverage. Defaults to 2 (pairwise),
+// also with a warning when the variable is not a number.
+uint32_t covering_array_strength();
+
+// Seed for CoveringCombine, from LZT_COMBINE_SEED. Defaults to 0, also with
+// a warning when the variable is not a number.
+uint32_t covering_array_seed();
+
+template <typename... Generator> class CoveringCombineHolder {
+public:
+  CoveringCombineHolder(uint32_t strength, uint32_t seed,
+                        const Generator &...generators)
+      : strength_(strength), seed_(seed), generators_(generators...) {}
+
+  template <typename... T>
+  operator ::testing::internal::ParamGenerator<std::tuple<T...>>() const {
+    static_assert(sizeof...(T) == sizeof...(Generator),
+                  "one generator per tuple element");
+    return rows<T...>(std::index_sequence_for<T...>());
+  }
+
+private:
+  template <typename T, typename G>
+  static std::vector<T> values(const G &generator) {
+    const auto param_generator =
+        static_cast<::testing::internal::ParamGenerator<T>>(generator);
+    std::vector<T> result;
+    for (auto it = param_generator.begin(); it != param_generator.end();
+         ++it) {
+      result.push_back(*it);
+    }
+    return result;
+  }
+
+  template <typename... T, size_t... I>
+  ::testing::internal::ParamGenerator<std::tuple<T...>>
+  rows(std::index_sequence<I...>) const {
+    const std::tuple<std::vector<T>...> parameters(
+        values<T>(std::get<I>(generators_))...);
+    const std::vector<size_t> value_counts = {
+        std::get<I>(parameters).size()...};
+
+    std::vector<std::tuple<T...>> result;
+    for (const auto &row : covering_array(value_counts, strength_, seed_)) {
+      result.emplace_back(std::get<I>(parameters)[row[I]]...);
+    }
+    return ::testing::ValuesIn(result);
+  }
+
+  const uint32_t strength_;
+  const uint32_t seed_;
+  const std::tuple<Generator...> generators_;
+};
+
+// Drop-in replacement for ::testing::Combine which instantiates a t-way
+// covering array of the generators instead of their full cartesian
+// product, see covering_array_strength. Pairwise coverage of a few
+// parameters with a few values each is usually an order of magnitude
+// fewer tests, while every pair of values is still tested together.
+template <typename... Generator>
+CoveringCombineHolder<Generator...>
+CoveringCombine(const Generator &...generators) {
+  return CoveringCombineHolder<Generator...>(
+      covering_array_strength(), covering_array_seed(), generators...);
+}
+
+// CoveringCombine with the given strength and seed instead of the ones of
+// LZT_COMBINE_STRENGTH and LZT_COMBINE_SEED.
+template <typename... Generator>
+CoveringCombineHolder<Generator...>
+CoveringCombineWith(uint32_t strength, uint32_t seed,
+                    const Generator &...generators) {
+  return CoveringCombineHolder<Generator...>(strength, seed, generators...);
+}
+
+} // namespace level_zero_tests
+
+#endif
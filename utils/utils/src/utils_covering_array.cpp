@@ -0,0 +1,238 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "utils/utils_covering_array.hpp"
+#include "logging/logging.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace level_zero_tests {
+
+namespace {
+
+// Value combinations of one set of columns which no row covers yet
+struct column_set_t {
+  std::vector<size_t> columns;
+  std::vector<bool> uncovered;
+};
+
+size_t combination_index(const column_set_t &set,
+                         const std::vector<size_t> &value_counts,
+                         const std::vector<size_t> &row) {
+  size_t index = 0;
+  for (auto column : set.columns) {
+    index = index * value_counts[column] + row[column];
+  }
+  return index;
+}
+
+// Last parameter varies fastest, as in ::testing::Combine
+std::vector<std::vector<size_t>>
+cartesian_product(const std::vector<size_t> &value_counts) {
+  std::vector<std::vector<size_t>> rows;
+  std::vector<size_t> row(value_counts.size(), 0);
+  while (true) {
+    rows.push_back(row);
+    size_t column = row.size();
+    while (column > 0 && ++row[column - 1] == value_counts[column - 1]) {
+      row[--column] = 0;
+    }
+    if (column == 0) {
+      return rows;
+    }
+  }
+}
+
+// std::uniform_int_distribution and std::shuffle differ between standard
+// libraries, the raw std::mt19937 sequence does not.
+size_t pick(std::mt19937 &engine, size_t count) { return engine() % count; }
+
+// Value of the environment variable name as a 32-bit unsigned number, or
+// default_value with a warning if it is not one
+uint32_t environment_number(const char *name, const char *value,
+                            uint32_t default_value) {
+  char *end = nullptr;
+  errno = 0;
+  const unsigned long number = std::strtoul(value, &end, 10);
+  if (end == value || *end != '\0' || errno == ERANGE ||
+      number > std::numeric_limits<uint32_t>::max()) {
+    LOG_WARNING << name << "=" << value << " is not a valid number, using "
+                << default_value;
+    return default_value;
+  }
+  return static_cast<uint32_t>(number);
+}
+
+} // namespace
+
+std::vector<std::vector<size_t>>
+covering_array(const std::vector<size_t> &value_counts, uint32_t strength,
+               uint32_t seed) {
+  const size_t parameter_count = value_counts.size();
+  for (auto count : value_counts) {
+    if (count == 0) {
+      return {};
+    }
+  }
+  if (strength == 0 || strength >= parameter_count) {
+    return cartesian_product(value_counts);
+  }
+
+  std::vector<column_set_t> sets;
+  std::vector<std::vector<size_t>> sets_of_column(parameter_count);
+  size_t uncovered_count = 0;
+  std::vector<size_t> columns(strength);
+  for (size_t i = 0; i < strength; i++) {
+    columns[i] = i;
+  }
+  while (true) {
+    column_set_t set;
+    set.columns = columns;
+    size_t combinations = 1;
+    for (auto column : columns) {
+      combinations *= value_counts[column];
+      sets_of_column[column].push_back(sets.size());
+    }
+    set.uncovered.assign(combinations, true);
+    uncovered_count += combinations;
+    sets.push_back(set);
+
+    size_t i = strength;
+    while (i > 0 && columns[i - 1] == parameter_count - strength + i - 1) {
+      i--;
+    }
+    if (i == 0) {
+      break;
+    }
+    columns[i - 1]++;
+    for (size_t j = i; j < strength; j++) {
+      columns[j] = columns[j - 1] + 1;
+    }
+  }
+
+  const uint32_t candidate_count = 16;
+  std::mt19937 engine(seed);
+  std::vector<std::vector<size_t>> rows;
+
+  while (uncovered_count > 0) {
+    size_t first_set = 0;
+    size_t first_combination = 0;
+    for (first_set = 0; first_set < sets.size(); first_set++) {
+      const auto &uncovered = sets[first_set].uncovered;
+      first_combination = 0;
+      while (first_combination < uncovered.size() &&
+             !uncovered[first_combination]) {
+        first_combination++;
+      }
+      if (first_combination < uncovered.size()) {
+        break;
+      }
+    }
+
+    // Every candidate covers the first uncovered combination, the other
+    // columns are filled in random order with the value covering the most
+    // combinations of the columns filled so far.
+    std::vector<size_t> best_row;
+    size_t best_gain = 0;
+    for (uint32_t candidate = 0; candidate < candidate_count; candidate++) {
+      std::vector<size_t> row(parameter_count, 0);
+      std::vector<bool> assigned(parameter_count, false);
+      size_t remainder = first_combination;
+      const auto &first_columns = sets[first_set].columns;
+      for (size_t i = first_columns.size(); i > 0; i--) {
+        const size_t column = first_columns[i - 1];
+        row[column] = remainder % value_counts[column];
+        remainder /= value_counts[column];
+        assigned[column] = true;
+      }
+
+      std::vector<size_t> order;
+      for (size_t column = 0; column < parameter_count; column++) {
+        if (!assigned[column]) {
+          order.push_back(column);
+        }
+      }
+      for (size_t i = order.size(); i > 1; i--) {
+        std::swap(order[i - 1], order[pick(engine, i)]);
+      }
+
+      for (auto column : order) {
+        const size_t first_value = pick(engine, value_counts[column]);
+        size_t best_value = first_value;
+        size_t best_value_gain = 0;
+        for (size_t offset = 0; offset < value_counts[column]; offset++) {
+          row[column] = (first_value + offset) % value_counts[column];
+          size_t gain = 0;
+          for (auto s : sets_of_column[column]) {
+            bool complete = true;
+            for (auto other : sets[s].columns) {
+              complete = complete && (other == column || assigned[other]);
+            }
+            if (complete &&
+                sets[s].uncovered[combination_index(sets[s], value_counts,
+                                                    row)]) {
+              gain++;
+            }
+          }
+          if (gain > best_value_gain) {
+            best_value = row[column];
+            best_value_gain = gain;
+          }
+        }
+        row[column] = best_value;
+        assigned[column] = true;
+      }
+
+      size_t gain = 0;
+      for (const auto &set : sets) {
+        if (set.uncovered[combination_index(set, value_counts, row)]) {
+          gain++;
+        }
+      }
+      if (gain > best_gain) {
+        best_row = row;
+        best_gain = gain;
+      }
+    }
+
+    for (auto &set : sets) {
+      const size_t index = combination_index(set, value_counts, best_row);
+      if (set.uncovered[index]) {
+        set.uncovered[index] = false;
+        uncovered_count--;
+      }
+    }
+    rows.push_back(best_row);
+  }
+  return rows;
+}
+
+uint32_t covering_array_strength() {
+  const char *strength = getenv("LZT_COMBINE_STRENGTH");
+  if (strength == nullptr) {
+    return 2;
+  }
+  if (std::string(strength) == "full") {
+    return 0;
+  }
+  return environment_number("LZT_COMBINE_STRENGTH", strength, 2);
+}
+
+uint32_t covering_array_seed() {
+  const char *seed = getenv("LZT_COMBINE_SEED");
+  if (seed == nullptr) {
+    return 0;
+  }
+  return environment_number("LZT_COMBINE_SEED", seed, 0);
+}
+
+} // namespace level_zero_tests
@@ -7,8 +7,11 @@
  */
 
 #include "utils/utils.hpp"
+#include "utils/utils_covering_array.hpp"
 #include "gtest/gtest.h"
 
+#include <bitset>
+
 template <typename T> class SizeInBytes : public testing::Test {};
 typedef testing::Types<uint8_t, int8_t, uint16_t, int16_t, uint32_t, int16_t,
                        uint64_t, int64_t, float, double>
@@ -384,4 +387,84 @@ LZT_TEST(XeImageTypeToString, InvalidValue) {
   EXPECT_EQ("Unknown ze_image_type_t value: " +
                 std::to_string(static_cast<int>(t)),
             level_zero_tests::to_string(t));
-}
\ No newline at end of file
+}
+
+namespace {
+// Whether every combination of values of any strength columns is in rows
+bool covers_all_combinations(const std::vector<std::vector<size_t>> &rows,
+                             const std::vector<size_t> &value_counts,
+                             uint32_t strength) {
+  for (auto &row :
+       level_zero_tests::covering_array(value_counts, 0, 0)) {
+    for (uint32_t mask = 0; mask < (1u << value_counts.size()); mask++) {
+      if (std::bitset<32>(mask).count() != strength) {
+        continue;
+      }
+      bool found = false;
+      for (auto &covering_row : rows) {
+        bool match = true;
+        for (size_t column = 0; column < value_counts.size(); column++) {
+          if ((mask & (1u << column)) && covering_row[column] != row[column]) {
+            match = false;
+          }
+        }
+        found = found || match;
+      }
+      if (!found) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+LZT_TEST(CoveringArray, FullStrengthIsCartesianProductInCombineOrder) {
+  const auto rows = level_zero_tests::covering_array({2, 3}, 0, 0);
+  const std::vector<std::vector<size_t>> expected = {
+      {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}};
+  EXPECT_EQ(expected, rows);
+  EXPECT_EQ(expected, level_zero_tests::covering_array({2, 3}, 2, 0));
+}
+
+LZT_TEST(CoveringArray, PairwiseCoversAllPairsWithFewerRows) {
+  const std::vector<size_t> value_counts = {2, 2, 2, 2, 3, 3};
+  const auto rows = level_zero_tests::covering_array(value_counts, 2, 0);
+  EXPECT_TRUE(covers_all_combinations(rows, value_counts, 2));
+  EXPECT_GE(rows.size(), 9u);
+  EXPECT_LE(rows.size(), 14u);
+}
+
+LZT_TEST(CoveringArray, ThreeWayCoversAllTriples) {
+  const std::vector<size_t> value_counts = {2, 2, 3, 4, 4, 2};
+  const auto rows = level_zero_tests::covering_array(value_counts, 3, 0);
+  EXPECT_TRUE(covers_all_combinations(rows, value_counts, 3));
+  EXPECT_LT(rows.size(), 2u * 2u * 3u * 4u * 4u * 2u);
+}
+
+LZT_TEST(CoveringArray, SameSeedGivesSameRows) {
+  const std::vector<size_t> value_counts = {3, 4, 2, 5, 3};
+  EXPECT_EQ(level_zero_tests::covering_array(value_counts, 2, 7),
+            level_zero_tests::covering_array(value_counts, 2, 7));
+  EXPECT_TRUE(covers_all_combinations(
+      level_zero_tests::covering_array(value_counts, 2, 7), value_counts, 2));
+}
+
+LZT_TEST(CoveringArray, EmptyParameterGivesNoRows) {
+  EXPECT_TRUE(level_zero_tests::covering_array({2, 0, 3}, 2, 0).empty());
+}
+
+LZT_TEST(CoveringCombine, ConvertsGeneratorsToCoveringRows) {
+  const ::testing::internal::ParamGenerator<std::tuple<int, bool, size_t>>
+      generator = level_zero_tests::CoveringCombineWith(
+          2, 0, ::testing::Values(1, 2, 3), ::testing::Bool(),
+          ::testing::Values(10, 20));
+  std::vector<std::vector<size_t>> rows;
+  for (auto &value : generator) {
+    rows.push_back({static_cast<size_t>(std::get<0>(value) - 1),
+                    std::get<1>(value) ? 1u : 0u,
+                    std::get<2>(value) / 10 - 1});
+  }
+  EXPECT_TRUE(covers_all_combinations(rows, {3, 2, 2}, 2));
+  EXPECT_LT(rows.size(), 12u);
+}